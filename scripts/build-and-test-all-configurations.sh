@@ -23,7 +23,7 @@ exit 0
 
 # All './configure' options except '-p' (pedantic).
 
-all="--default --extreme -m32 --ultimate -c -g -l -s --coverage --profile --compact --no-options --quiet --metrics --stats --no-proofs -fPIC --shared --kitten --no-metrics --no-stats"
+all="--default --extreme -m32 --ultimate -c -g -l -s --coverage --profile --compact --huge-arena --no-options --quiet --metrics --stats --no-proofs --no-prefetch --no-huge-pages -fPIC --shared --kitten --no-metrics --no-stats"
 
 tmp=/tmp/m32-support-$$
 cat <<EOF > $tmp.c
@@ -235,10 +235,12 @@ done
 redundant () {
   case $1$2 in
     -c-g) return 0;;
+    --compact--huge-arena) return 0;;
     --default--no-metrics) return 0;;
     --default--no-stats) return 0;;
     --extreme--ultimate) return 0;;
     --extreme--compact) return 0;;
+    --extreme--huge-arena) return 0;;
     --extreme-l) return 0;;
     --extreme--no-options) return 0;;
     --extreme--quiet) return 0;;
@@ -254,6 +256,7 @@ redundant () {
     --no-metrics--no-stats) return 0;;
     --stats--no-stats) return 0;;
     --ultimate--compact) return 0;;
+    --ultimate--huge-arena) return 0;;
     --ultimate-l) return 0;;
     --ultimate--no-options) return 0;;
     --ultimate--quiet) return 0;;
@@ -12,12 +12,30 @@
 #include <inttypes.h>
 #endif
 
+// Aligned allocation requires POSIX ('posix_memalign').
+
+#if !defined(NHUGEPAGES) && !defined(_POSIX_C_SOURCE)
+#define NHUGEPAGES
+#endif
+
+#ifndef NHUGEPAGES
+#include <stdint.h>
+#include <sys/mman.h>
+#endif
+
 static void
 inc_bytes (kissat * solver, size_t bytes)
 {
-#ifdef METRICS
   if (!solver)
     return;
+  solver->allocated += bytes;
+  memory *memory = &solver->memory;
+  const unsigned tag = memory->tag;
+  assert (tag < MEM_TAGS);
+  const size_t current = memory->current[tag] += bytes;
+  if (current > memory->peak[tag])
+    memory->peak[tag] = current;
+#ifdef METRICS
   ADD (allocated_current, bytes);
   LOG5 ("allocated_current = %s",
 	FORMAT_BYTES (solver->statistics.allocated_current));
@@ -28,34 +46,99 @@ inc_bytes (kissat * solver, size_t bytes)
       LOG5 ("allocated_max = %s",
 	    FORMAT_BYTES (solver->statistics.allocated_max));
     }
-#else
-  (void) solver;
-  (void) bytes;
 #endif
 }
 
 static void
 dec_bytes (kissat * solver, size_t bytes)
 {
-#ifdef METRICS
   if (!solver)
     return;
+  assert (solver->allocated >= bytes);
+  solver->allocated -= bytes;
+  memory *memory = &solver->memory;
+  const unsigned tag = memory->tag;
+  assert (tag < MEM_TAGS);
+  assert (memory->current[tag] >= bytes);
+  memory->current[tag] -= bytes;
+#ifdef METRICS
   SUB (allocated_current, bytes);
   LOG5 ("allocated_current = %s",
 	FORMAT_BYTES (solver->statistics.allocated_current));
+#endif
+}
+
+#ifndef NHUGEPAGES
+
+// Large blocks (the arena, the vector store and the variable and literal
+// indexed arrays of big instances) are aligned to huge page boundaries and
+// marked to be backed by transparent huge pages, which reduces TLB misses.
+// Such blocks are still released with 'free' and thus the deallocation
+// functions do not need to know how a block was allocated.  Only blocks
+// growing beyond the threshold are moved to an aligned block once, while
+// already large blocks are reallocated in place (or remapped) and then
+// marked again.  Cleared blocks are allocated with 'calloc', which does
+// not need to clear freshly mapped pages, and then marked too, since
+// their huge page aligned part is still covered by huge pages.
+
+#define HUGE_PAGE_SIZE ((size_t) 1 << 21)
+
+static bool
+huge_allocation (kissat * solver, size_t bytes)
+{
+  if (!solver)
+    return false;
+  if (bytes < HUGE_PAGE_SIZE)
+    return false;
+  return GET_OPTION (hugepages);
+}
+
+static void
+advise_huge (void *ptr, size_t bytes)
+{
+#ifdef MADV_HUGEPAGE
+  const uintptr_t start = (uintptr_t) ptr;
+  const uintptr_t end = start + bytes;
+  const uintptr_t mask = HUGE_PAGE_SIZE - 1;
+  const uintptr_t aligned = (start + mask) & ~mask;
+  if (aligned < end && end - aligned >= HUGE_PAGE_SIZE)
+    (void) madvise ((void *) aligned, end - aligned, MADV_HUGEPAGE);
 #else
-  (void) solver;
-  (void) bytes;
+  (void) ptr, (void) bytes;
 #endif
 }
 
+static void *
+allocate_huge (size_t bytes)
+{
+  void *res;
+  if (posix_memalign (&res, HUGE_PAGE_SIZE, bytes))
+    return 0;
+  advise_huge (res, bytes);
+  return res;
+}
+
+static void *
+allocate_block (kissat * solver, size_t bytes)
+{
+  if (huge_allocation (solver, bytes))
+    return allocate_huge (bytes);
+  return malloc (bytes);
+}
+
+#else
+
+#define allocate_block(SOLVER,BYTES) malloc (BYTES)
+
+#endif
+
 void *
 kissat_malloc (kissat * solver, size_t bytes)
 {
   void *res;
   if (!bytes)
     return 0;
-  res = malloc (bytes);
+  res = allocate_block (solver, bytes);
   LOG4 ("malloc (%zu) = %p", bytes, res);
   if (!res)
     kissat_fatal ("out-of-memory allocating %zu bytes", bytes);
@@ -85,7 +168,7 @@ kissat_nalloc (kissat * solver, size_t n, size_t size)
   if (MAX_SIZE_T / size < n)
     kissat_fatal ("invalid 'kissat_nalloc (..., %zu, %zu)' call", n, size);
   const size_t bytes = n * size;
-  res = malloc (bytes);
+  res = allocate_block (solver, bytes);
   LOG4 ("nalloc (%zu, %zu) = %p", n, size, res);
   if (!res)
     kissat_fatal ("out-of-memory allocating "
@@ -103,9 +186,13 @@ kissat_calloc (kissat * solver, size_t n, size_t size)
     return 0;
   if (MAX_SIZE_T / size < n)
     kissat_fatal ("invalid 'kissat_calloc (..., %zu, %zu)' call", n, size);
+  const size_t bytes = n * size;
   res = calloc (n, size);
+#ifndef NHUGEPAGES
+  if (res && huge_allocation (solver, bytes))
+    advise_huge (res, bytes);
+#endif
   LOG4 ("calloc (%zu, %zu) = %p", n, size, res);
-  const size_t bytes = n * size;
   if (!res)
     kissat_fatal ("out-of-memory allocating "
 		  "%zu = %zu x %zu bytes", bytes, n, size);
@@ -135,7 +222,26 @@ kissat_realloc (kissat * solver, void *p, size_t old_bytes, size_t new_bytes)
       return 0;
     }
   dec_bytes (solver, old_bytes);
-  void *res = realloc (p, new_bytes);
+  void *res;
+#ifndef NHUGEPAGES
+  if (old_bytes < HUGE_PAGE_SIZE && huge_allocation (solver, new_bytes))
+    {
+      res = allocate_huge (new_bytes);
+      if (res && p)
+	{
+	  memcpy (res, p, old_bytes);
+	  free (p);
+	}
+    }
+  else
+#endif
+    {
+      res = realloc (p, new_bytes);
+#ifndef NHUGEPAGES
+      if (res && huge_allocation (solver, new_bytes))
+	advise_huge (res, new_bytes);
+#endif
+    }
   LOG4 ("realloc (%p[%zu], %zu) = %p", p, old_bytes, new_bytes, res);
   if (new_bytes && !res)
     kissat_fatal ("out-of-memory reallocating from %zu to %zu bytes",
@@ -102,7 +102,11 @@ one_literal_on_conflict_level (kissat * solver,
 	    }
 	  lits[highest_position] = lit;
 	  lits[i] = highest_literal;
-	  if (highest_position > 1)
+	  if (highest_position < 2)
+	    continue;
+	  if (kissat_watching_ternary (solver, conflict_size))
+	    kissat_watch_ternary (solver, lits[i], lits[!i], lits[2], ref);
+	  else
 	    kissat_watch_blocking (solver, lits[i], lits[!i], ref);
 	}
     }
@@ -608,6 +612,7 @@ kissat_analyze (kissat * solver, clause * conflict)
     {
       LOGCLS (conflict, "analyzing conflict %" PRIu64, CONFLICTS);
       unsigned conflict_level;
+      clause *subsuming;
       if (one_literal_on_conflict_level (solver, conflict, &conflict_level))
 	res = 1;
       else if (!conflict_level)
@@ -617,8 +622,10 @@ kissat_analyze (kissat * solver, clause * conflict)
 	  analyze_failed_literal (solver, conflict);
 	  res = 1;
 	}
-      else if ((conflict = kissat_deduce_first_uip_clause (solver, conflict)))
+      else if ((subsuming =
+		kissat_deduce_first_uip_clause (solver, conflict)))
 	{
+	  conflict = subsuming;
 	  reset_analysis_but_not_analyzed_literals (solver);
 	  res = 0;
 	}
@@ -632,6 +639,7 @@ kissat_analyze (kissat * solver, clause * conflict)
 		kissat_shrink_clause (solver);
 	    }
 	  analyze_reason_side_literals (solver);
+	  ADD_LEARNED_HINTS_TO_PROOF (conflict);
 	  kissat_learn_clause (solver);
 	  reset_analysis_but_not_analyzed_literals (solver);
 	  res = 1;
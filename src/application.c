@@ -22,10 +22,14 @@ struct application
 {
   kissat *solver;
   const char *input_path;
+  const char *binary_cnf_path;
+  const char *checkpoint_path;
+  int checkpoint_every;
 #ifndef NPROOFS
   const char *proof_path;
   file proof_file;
   int binary;
+  bool frat;
 #endif
 #if !defined(NPROOFS) || !defined (_POSIX_C_SOURCE)
   bool force;
@@ -33,6 +37,8 @@ struct application
   int time;
   int conflicts;
   int decisions;
+  int memlimit;
+  int threads;
   strictness strict;
   bool partial;
   bool witness;
@@ -48,7 +54,11 @@ init_app (application * application, kissat * solver)
   application->time = 0;
   application->conflicts = -1;
   application->decisions = -1;
+  application->memlimit = -1;
   application->strict = NORMAL_PARSING;
+  // The stand-alone solver calls 'kissat_solve' only once and thus does
+  // not need to save both sides of eliminated clauses (unless asked to).
+  kissat_set_option (solver, "incremental", 0);
 }
 
 static void
@@ -74,6 +84,21 @@ print_complete_dimacs_and_proof_usage (void)
   printf ("the input file on-the-fly after checking that the input file\n");
   printf ("has the correct format (starts with the corresponding\n");
   printf ("signature bytes).\n");
+#endif
+#ifdef BUILTIN_DECOMPRESSION
+  printf ("\n");
+  printf ("This solver was built with in-process decompression for\n");
+  printf ("the following formats, which does not require these tools:\n");
+  printf ("\n");
+#ifdef BZIP2
+  printf ("  '.bz2'           (through 'libbz2')\n");
+#endif
+#ifdef ZLIB
+  printf ("  '.gz'            (through 'zlib')\n");
+#endif
+#ifdef LZMA
+  printf ("  '.lzma' '.xz'    (through 'liblzma')\n");
+#endif
 #endif
   printf ("\n");
 #ifndef NPROOFS
@@ -85,6 +110,11 @@ print_complete_dimacs_and_proof_usage (void)
     ("is used.  For real files the binary proof format is used unless\n");
   printf ("'--no-binary' is specified.\n");
   printf ("\n");
+  printf ("With '--frat' the proof is written in the ASCII FRAT format\n");
+  printf ("instead, where every clause has an identifier and learned\n");
+  printf ("clauses list the identifiers of their antecedents.  Such\n");
+  printf ("proofs can be elaborated to LRAT proofs by 'frat-rs'.\n");
+  printf ("\n");
 #ifdef _POSIX_C_SOURCE
   printf ("Writing of compressed proof files follows the same principle\n");
   printf ("as reading compressed files. The compression format is based\n");
@@ -201,6 +231,7 @@ print_complete_usage (void)
 #endif
 #ifndef NPROOFS
   printf ("  --force              same as '-f' (force writing proof)\n");
+  printf ("  --frat               write proof in FRAT format\n");
 #endif
   printf ("  --id                 print 'git' identifier (SHA-1 hash)\n");
 #ifndef NOPTIONS
@@ -210,12 +241,23 @@ print_complete_usage (void)
 	  " (ignore DIMACS header)\n");
   printf ("  --strict             stricter parsing"
 	  " (no empty header lines)\n");
+  printf ("  --threads=<number>   "
+	  "solve with portfolio of diversified solvers\n");
   printf ("  --version            print version\n");
   printf ("\n");
+  printf ("  --write-binary-cnf=<file>  "
+	  "write input in binary CNF format and exit\n");
+  printf ("\n");
+  printf ("  --checkpoint=<file>         "
+	  "resume from and write checkpoints to file\n");
+  printf ("  --checkpoint-every=<seconds>  "
+	  "checkpoint interval (default 600)\n");
+  printf ("\n");
   printf ("The following solving limits can be enforced:\n");
   printf ("\n");
   printf ("  --conflicts=<limit>\n");
   printf ("  --decisions=<limit>\n");
+  printf ("  --memlimit=<megabytes>\n");
   printf ("  --time=<seconds>\n");
   printf ("\n");
   printf
@@ -540,11 +582,76 @@ parse_options (application * application, int argc, char **argv)
 	  else
 	    ERROR ("invalid argument in '%s' (try '-h')", arg);
 	}
+      else if ((valstr = kissat_parse_option_name (arg, "memlimit")))
+	{
+	  int val;
+	  if (kissat_parse_option_value (valstr, &val) && val >= 0)
+	    {
+	      if (application->memlimit >= 0)
+		ERROR ("multiple '--memlimit=%d' and '%s'",
+		       application->memlimit, arg);
+	      kissat_set_memory_limit (solver, val);
+	      application->memlimit = val;
+	    }
+	  else
+	    ERROR ("invalid argument in '%s' (try '-h')", arg);
+	}
+      else if ((valstr = kissat_parse_option_name (arg, "threads")))
+	{
+	  int val;
+	  if (kissat_parse_option_value (valstr, &val) && val > 0)
+	    {
+	      if (application->threads > 0)
+		ERROR ("multiple '--threads=%d' and '%s'",
+		       application->threads, arg);
+	      kissat_set_threads (solver, val);
+	      application->threads = val;
+	    }
+	  else
+	    ERROR ("invalid argument in '%s' (try '-h')", arg);
+	}
       else if (!strcmp (arg, "--partial"))
 	application->partial = true;
+      else if ((valstr = kissat_parse_option_name (arg, "checkpoint")))
+	{
+	  if (application->checkpoint_path)
+	    ERROR ("multiple '--checkpoint=%s' and '%s'",
+		   application->checkpoint_path, arg);
+	  if (!*valstr)
+	    ERROR ("missing file in '%s' (try '-h')", arg);
+	  if (!kissat_file_writable (valstr))
+	    ERROR ("can not write checkpoint to '%s'", valstr);
+	  application->checkpoint_path = valstr;
+	}
+      else if ((valstr = kissat_parse_option_name (arg, "checkpoint-every")))
+	{
+	  int val;
+	  if (kissat_parse_option_value (valstr, &val) && val > 0)
+	    {
+	      if (application->checkpoint_every > 0)
+		ERROR ("multiple '--checkpoint-every=%d' and '%s'",
+		       application->checkpoint_every, arg);
+	      application->checkpoint_every = val;
+	    }
+	  else
+	    ERROR ("invalid argument in '%s' (try '-h')", arg);
+	}
+      else if ((valstr = kissat_parse_option_name (arg, "write-binary-cnf")))
+	{
+	  if (application->binary_cnf_path)
+	    ERROR ("multiple '--write-binary-cnf=%s' and '%s'",
+		   application->binary_cnf_path, arg);
+	  if (!*valstr)
+	    ERROR ("missing file in '%s' (try '-h')", arg);
+	  if (!kissat_file_writable (valstr))
+	    ERROR ("can not write binary CNF to '%s'", valstr);
+	  application->binary_cnf_path = valstr;
+	}
 #ifndef NPROOFS
       else if (LONG_FALSE_OPTION (arg, "binary"))
 	application->binary = -1;
+      else if (LONG_TRUE_OPTION (arg, "frat"))
+	application->frat = true;
 #endif
 #ifndef NOPTIONS
       else if (arg[0] == '-' && arg[1] == '-' &&
@@ -656,6 +763,42 @@ parse_options (application * application, int argc, char **argv)
 	  application->input_path = arg;
 	}
     }
+  if (application->checkpoint_every && !application->checkpoint_path)
+    ERROR ("'--checkpoint-every=%d' without '--checkpoint=<file>'",
+	   application->checkpoint_every);
+  if (application->threads > 1)
+    {
+#ifndef NPROOFS
+      if (application->proof_path)
+	ERROR ("can not write proof with multiple threads");
+#endif
+      if (application->checkpoint_path)
+	ERROR ("can not use checkpoints with multiple threads");
+    }
+  if (application->checkpoint_path)
+    {
+#ifndef NPROOFS
+      if (application->proof_path)
+	ERROR ("can not write proof and checkpoints at the same time");
+#endif
+      if (application->binary_cnf_path)
+	ERROR ("can not write binary CNF and checkpoints at the same time");
+      if (application->input_path &&
+	  !strcmp (application->input_path, application->checkpoint_path))
+	ERROR ("will not read and write '%s' at the same time",
+	       application->input_path);
+    }
+  if (application->binary_cnf_path)
+    {
+#ifndef NPROOFS
+      if (application->proof_path)
+	ERROR ("can not write proof and binary CNF at the same time");
+#endif
+      if (application->input_path &&
+	  !strcmp (application->input_path, application->binary_cnf_path))
+	ERROR ("will not read and write '%s' at the same time",
+	       application->input_path);
+    }
 #ifndef _POSIX_C_SOURCE
   if (!application->force &&
       application->input_path &&
@@ -720,6 +863,76 @@ parse_input (application * application)
   return true;
 }
 
+static bool
+write_binary_cnf (application * application)
+{
+#ifndef QUIET
+  double entered = kissat_process_time ();
+#endif
+  kissat *solver = application->solver;
+  uint64_t lineno;
+  file input, output;
+  const char *path = application->input_path;
+  if (!path)
+    kissat_read_already_open_file (&input, stdin, "<stdin>");
+  else if (!kissat_open_to_read_file (&input, path))
+    ERROR ("failed to open '%s' for reading", path);
+  const char *binary_cnf_path = application->binary_cnf_path;
+  if (!kissat_open_to_write_file (&output, binary_cnf_path))
+    {
+      kissat_close_file (&input);
+      ERROR ("failed to open '%s' for writing", binary_cnf_path);
+    }
+  kissat_section (solver, "converting");
+  kissat_message (solver, "reading %sinput file:",
+		  input.compressed ? "compressed " : "");
+  kissat_line (solver);
+  kissat_message (solver, "  %s", input.path);
+  kissat_line (solver);
+  kissat_message (solver, "writing %sbinary CNF file:",
+		  output.compressed ? "compressed " : "");
+  kissat_line (solver);
+  kissat_message (solver, "  %s", output.path);
+  kissat_line (solver);
+  const char *error =
+    kissat_write_binary_cnf (solver, application->strict, &input, &output,
+			     &lineno, &application->max_var);
+  kissat_close_file (&input);
+  kissat_close_file (&output);
+  if (error)
+    ERROR ("%s:%" PRIu64 ": parse error: %s", input.path, lineno, error);
+#ifndef QUIET
+  kissat_message (solver, "read %s and wrote %s",
+		  FORMAT_BYTES (input.bytes), FORMAT_BYTES (output.bytes));
+  kissat_message (solver,
+		  "finished conversion after %.2f seconds",
+		  kissat_process_time () - entered);
+#endif
+  return true;
+}
+
+static bool
+restore_checkpoint (application * application, bool *restored)
+{
+  const char *path = application->checkpoint_path;
+  if (!path || !kissat_file_readable (path))
+    return true;
+  kissat *solver = application->solver;
+  if (!kissat_restore (solver, path))
+    ERROR ("failed to restore checkpoint '%s'", path);
+  const size_t size = SIZE_STACK (solver->import);
+  application->max_var = size ? size - 1 : 0;
+#ifndef QUIET
+  kissat_section (solver, "checkpoint");
+  kissat_message (solver, "restored checkpoint '%s'", path);
+  kissat_message (solver, "instead of parsing '%s'",
+		  application->input_path ? application->input_path :
+		  "<stdin>");
+#endif
+  *restored = true;
+  return true;
+}
+
 #ifndef NPROOFS
 
 static bool
@@ -739,13 +952,17 @@ write_proof (application * application)
     ERROR ("failed to open and write proof to '%s'", path);
   else if (application->binary < 0)
     binary = false;
-  kissat_init_proof (application->solver, file, binary);
+  const bool frat = application->frat;
+  if (frat)
+    binary = false;
+  kissat_init_proof (application->solver, file, binary, frat);
 #ifndef QUIET
   kissat *solver = application->solver;
   kissat_section (solver, "proving");
-  kissat_message (solver, "%swriting proof to %sDRAT file:",
+  kissat_message (solver, "%swriting proof to %s%s file:",
 		  file->close ? "opened and " : "",
-		  file->compressed ? "compressed " : "");
+		  file->compressed ? "compressed " : "",
+		  frat ? "FRAT" : "DRAT");
   kissat_line (solver);
   kissat_message (solver, "  %s", file->path);
 #endif
@@ -808,14 +1025,15 @@ print_limits (application * application)
 {
   kissat *solver = application->solver;
   const int verbosity = kissat_verbosity (solver);
-  if (verbosity < 1 &&
-      application->conflicts < 0 && application->decisions < 0)
+  if (verbosity < 1 && application->conflicts < 0 &&
+      application->decisions < 0 && application->memlimit < 0)
     return;
 
   kissat_section (solver, "limits");
-  if (!application->time &&
-      application->conflicts < 0 && application->decisions < 0)
-    kissat_message (solver, "no time, conflict nor decision limit set");
+  if (!application->time && application->conflicts < 0 &&
+      application->decisions < 0 && application->memlimit < 0)
+    kissat_message (solver,
+		    "no time, conflict, decision nor memory limit set");
   else
     {
       if (application->time)
@@ -837,6 +1055,12 @@ print_limits (application * application)
 			application->decisions);
       else if (verbosity > 0)
 	kissat_message (solver, "no decision limit");
+
+      if (application->memlimit >= 0)
+	kissat_message (solver,
+			"memory limit set to %d MB", application->memlimit);
+      else if (verbosity > 0)
+	kissat_message (solver, "no memory limit");
     }
 }
 
@@ -865,17 +1089,29 @@ run_application (kissat * solver,
       fflush (stdout);
     }
 #endif
+  if (application.binary_cnf_path)
+    return write_binary_cnf (&application) ? 0 : 1;
 #ifndef NPROOFS
   if (!write_proof (&application))
     return 1;
 #endif
-  if (!parse_input (&application))
+  bool restored = false;
+  if (!restore_checkpoint (&application, &restored))
+    return 1;
+  if (!restored && !parse_input (&application))
     {
 #ifndef NPROOFS
       close_proof (&application);
 #endif
       return 1;
     }
+  if (application.checkpoint_path)
+    {
+      int every = application.checkpoint_every;
+      if (!every)
+	every = 600;
+      kissat_set_checkpoint (solver, application.checkpoint_path, every);
+    }
 #ifndef QUIET
 #ifndef NOPTIONS
   print_options (solver);
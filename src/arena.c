@@ -3,6 +3,18 @@
 #include "logging.h"
 #include "print.h"
 
+#include <string.h>
+
+#ifdef _POSIX_C_SOURCE
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#if defined(MAP_ANONYMOUS) && defined(MAP_NORESERVE)
+#define MAPPED_ARENA
+#endif
+
 static void
 report_resized (kissat * solver, const char *mode, arena before)
 {
@@ -24,6 +36,166 @@ report_resized (kissat * solver, const char *mode, arena before)
 #endif
 }
 
+// A mapped arena is not allocated through 'kissat_malloc'.  Instead of its
+// reserved address space its used part is accounted to the arena.
+
+size_t
+kissat_mapped_arena_bytes (kissat * solver)
+{
+  if (!solver->arena_mapped)
+    return 0;
+  return SIZE_STACK (solver->arena) * sizeof (ward);
+}
+
+static void
+update_mapped_arena_peak (kissat * solver)
+{
+  memory *memory = &solver->memory;
+  const size_t current =
+    memory->current[MEM_arena] + kissat_mapped_arena_bytes (solver);
+  if (current > memory->peak[MEM_arena])
+    memory->peak[MEM_arena] = current;
+}
+
+#ifdef MAPPED_ARENA
+
+// Doubling a large arena copies all clauses and temporarily needs three
+// times the memory of the old arena.  Instead, as soon as the arena
+// becomes large, we reserve address space for the largest possible arena
+// once.  The kernel then only provides physical memory for the pages
+// actually used and growing the arena never moves clauses anymore.  This
+// is only done on 64-bit systems and if the address space is unlimited,
+// since otherwise the reservation would count against that limit.
+
+#define MAP_ARENA_BYTES ((size_t) 1 << 26)
+
+static bool
+map_arena (kissat * solver)
+{
+  if (sizeof (word) < 8)
+    return false;
+  if (!GET_OPTION (arenamap))
+    return false;
+  struct rlimit limit;
+  if (getrlimit (RLIMIT_AS, &limit) || limit.rlim_cur != RLIM_INFINITY)
+    return false;
+  const size_t bytes = MAX_ARENA * sizeof (ward);
+  void *map = mmap (0, bytes, PROT_READ | PROT_WRITE,
+		    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (map == MAP_FAILED)
+    return false;
+#if defined(MADV_HUGEPAGE) && !defined(NHUGEPAGES)
+  if (GET_OPTION (hugepages))
+    (void) madvise (map, bytes, MADV_HUGEPAGE);
+#endif
+  ward *const begin = BEGIN_STACK (solver->arena);
+  const size_t size = SIZE_STACK (solver->arena);
+  const size_t capacity = CAPACITY_STACK (solver->arena);
+  if (size)
+    memcpy (map, begin, size * sizeof (ward));
+  ACCOUNT (arena, kissat_free (solver, begin, capacity * sizeof (ward)));
+  solver->arena.begin = map;
+  solver->arena.end = solver->arena.begin + size;
+  solver->arena.allocated = solver->arena.begin + MAX_ARENA;
+  solver->arena_mapped = true;
+  update_mapped_arena_peak (solver);
+  return true;
+}
+
+#endif
+
+static void
+enlarge_arena (kissat * solver, size_t needed)
+{
+  const size_t size = SIZE_STACK (solver->arena);
+  size_t capacity = CAPACITY_STACK (solver->arena);
+  assert (kissat_is_power_of_two (MAX_ARENA));
+  assert (capacity <= MAX_ARENA);
+  size_t available = capacity - size;
+  if (needed <= available)
+    return;
+  const arena before = solver->arena;
+#ifdef MAPPED_ARENA
+  size_t wanted = 2 * capacity;
+  if (wanted < size + needed)
+    wanted = size + needed;
+  if (!solver->arena_mapped && needed <= MAX_ARENA - size &&
+      wanted * sizeof (ward) >= MAP_ARENA_BYTES && map_arena (solver))
+    {
+      INC (arena_resized);
+      INC (arena_enlarged);
+      report_resized (solver, "mapped", before);
+      return;
+    }
+#endif
+  do
+    {
+      assert (kissat_is_zero_or_power_of_two (capacity));
+      if (capacity == MAX_ARENA)
+	kissat_fatal ("maximum arena capacity "
+		      "of 2^%u %zu-byte-words %s exhausted"
+#if defined(COMPACT)
+		      " (consider a configuration without '--compact')"
+#elif !defined(HUGEARENA)
+		      " (consider a configuration with '--huge-arena')"
+#endif
+		      ,
+		      LD_MAX_ARENA, sizeof (ward),
+		      FORMAT_BYTES (MAX_ARENA * sizeof (ward)));
+      ACCOUNT (arena, kissat_stack_enlarge (solver, (chars *) & solver->arena,
+					    sizeof (ward)));
+      capacity = CAPACITY_STACK (solver->arena);
+      available = capacity - size;
+    }
+  while (needed > available);
+  INC (arena_resized);
+  INC (arena_enlarged);
+  report_resized (solver, "enlarged", before);
+  assert (capacity <= MAX_ARENA);
+}
+
+void
+kissat_reserve_arena (kissat * solver, size_t clauses, size_t literals)
+{
+  LOG ("reserving arena space for %zu clauses with %zu literals",
+       clauses, literals);
+  const size_t size = SIZE_STACK (solver->arena);
+  const size_t limit = MAX_ARENA - size;
+  const size_t header = sizeof (clause) / sizeof (ward) + 1;
+  size_t needed = 0;
+  if (clauses > limit / header)
+    needed = limit;
+  else
+    {
+      needed = clauses * header;
+      const size_t words = literals / sizeof (ward) * sizeof (unsigned);
+      if (words > limit - needed)
+	needed = limit;
+      else
+	needed += words + 1;
+    }
+  enlarge_arena (solver, needed);
+}
+
+// The table of 'cold' clause metadata has one entry for each 'ward' of
+// the arena and is thus indexed by clause reference.  Only the entries of
+// clause references are used, but this way clauses can be moved and the
+// table can grow and shrink together with the arena.
+
+static void
+resize_colds (kissat * solver)
+{
+  const size_t old_size = SIZE_STACK (solver->colds);
+  const size_t new_size = SIZE_STACK (solver->arena);
+  while (CAPACITY_STACK (solver->colds) < new_size)
+    ACCOUNT (arena, kissat_stack_enlarge (solver, (chars *) & solver->colds,
+					  sizeof (cold)));
+  solver->colds.end = solver->colds.begin + new_size;
+  if (old_size < new_size)
+    memset (solver->colds.begin + old_size, 0,
+	    (new_size - old_size) * sizeof (cold));
+}
+
 reference
 kissat_allocate_clause (kissat * solver, size_t size)
 {
@@ -34,45 +206,49 @@ kissat_allocate_clause (kissat * solver, size_t size)
   assert (kissat_aligned_word (bytes));
   const size_t needed = bytes / sizeof (ward);
   assert (needed <= UINT_MAX);
-  size_t capacity = CAPACITY_STACK (solver->arena);
-  assert (kissat_is_power_of_two (MAX_ARENA));
-  assert (capacity <= MAX_ARENA);
-  size_t available = capacity - res;
-  if (needed > available)
-    {
-      const arena before = solver->arena;
-      do
-	{
-	  assert (kissat_is_zero_or_power_of_two (capacity));
-	  if (capacity == MAX_ARENA)
-	    kissat_fatal ("maximum arena capacity "
-			  "of 2^%u %zu-byte-words %s exhausted"
-#ifdef COMPACT
-			  " (consider a configuration without '--compact')"
-#endif
-			  ,
-			  LD_MAX_ARENA, sizeof (ward),
-			  FORMAT_BYTES (MAX_ARENA * sizeof (ward)));
-	  kissat_stack_enlarge (solver, (chars *) & solver->arena,
-				sizeof (ward));
-	  capacity = CAPACITY_STACK (solver->arena);
-	  available = capacity - res;
-	}
-      while (needed > available);
-      INC (arena_resized);
-      INC (arena_enlarged);
-      report_resized (solver, "enlarged", before);
-      assert (capacity <= MAX_ARENA);
-    }
+  enlarge_arena (solver, needed);
   solver->arena.end += needed;
+  resize_colds (solver);
+  if (solver->arena_mapped)
+    update_mapped_arena_peak (solver);
   LOG ("allocated clause[%zu] of size %zu bytes %s",
        res, size, FORMAT_BYTES (bytes));
   return (reference) res;
 }
 
+#ifdef MAPPED_ARENA
+
+static void
+unmap_unused_arena (kissat * solver)
+{
+  const size_t page = sysconf (_SC_PAGESIZE);
+  char *const begin = (char *) BEGIN_STACK (solver->arena);
+  char *const end = (char *) END_STACK (solver->arena);
+  char *const allocated = (char *) solver->arena.allocated;
+  const size_t used = end - begin;
+  char *const unused = begin + (used + page - 1) / page * page;
+  if (unused >= allocated)
+    return;
+  (void) madvise (unused, allocated - unused, MADV_DONTNEED);
+  kissat_phase (solver, "arena", GET (arena_resized),
+		"released unused pages of mapped arena");
+}
+
+#endif
+
 void
 kissat_shrink_arena (kissat * solver)
 {
+  resize_colds (solver);
+  if (SIZE_STACK (solver->colds) <= CAPACITY_STACK (solver->colds) / 4)
+    ACCOUNT (arena, SHRINK_STACK (solver->colds));
+#ifdef MAPPED_ARENA
+  if (solver->arena_mapped)
+    {
+      unmap_unused_arena (solver);
+      return;
+    }
+#endif
   const arena before = solver->arena;
   const size_t capacity = CAPACITY_STACK (before);
   const size_t size = SIZE_STACK (before);
@@ -97,10 +273,26 @@ kissat_shrink_arena (kissat * solver)
     }
   INC (arena_resized);
   INC (arena_shrunken);
-  SHRINK_STACK (solver->arena);
+  ACCOUNT (arena, SHRINK_STACK (solver->arena));
   report_resized (solver, "shrunken", before);
 }
 
+void
+kissat_release_arena (kissat * solver)
+{
+  ACCOUNT (arena, RELEASE_STACK (solver->colds));
+#ifdef MAPPED_ARENA
+  if (solver->arena_mapped)
+    {
+      (void) munmap (BEGIN_STACK (solver->arena), MAX_ARENA * sizeof (ward));
+      memset (&solver->arena, 0, sizeof solver->arena);
+      solver->arena_mapped = false;
+      return;
+    }
+#endif
+  ACCOUNT (arena, RELEASE_STACK (solver->arena));
+}
+
 #if !defined(NDEBUG) || defined(LOGGING)
 
 bool
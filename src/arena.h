@@ -5,8 +5,17 @@
 #include "stack.h"
 #include "utilities.h"
 
-#ifdef COMPACT
+// Clause references are offsets into the arena counted in 'ward's and
+// thus limited to 2^31 'ward's.  The default 16-byte 'ward' allows 32 GB of
+// clauses.  With '--compact' the arena is limited to 16 GB (on 64-bit) but
+// clauses are padded less.  With '--huge-arena' a 'ward' is a 64-byte cache
+// line which raises the limit to 128 GB, while references and watches keep
+// their size.  The price is more padding for short clauses.
+
+#if defined(COMPACT)
 typedef word ward;
+#elif defined(HUGEARENA)
+typedef w8rd ward;
 #else
 typedef w2rd ward;
 #endif
@@ -29,6 +38,9 @@ struct kissat;
 
 reference kissat_allocate_clause (struct kissat *, size_t size);
 void kissat_shrink_arena (struct kissat *);
+void kissat_release_arena (struct kissat *);
+void kissat_reserve_arena (struct kissat *, size_t clauses, size_t literals);
+size_t kissat_mapped_arena_bytes (struct kissat *);
 
 #if !defined(NDEBUG) || defined(LOGGING)
 
@@ -39,8 +51,10 @@ bool kissat_clause_in_arena (const struct kissat *, const struct clause *);
 static inline word
 kissat_align_ward (word w)
 {
-#ifdef COMPACT
+#if defined(COMPACT)
   return kissat_align_word (w);
+#elif defined(HUGEARENA)
+  return kissat_align_w8rd (w);
 #else
   return kissat_align_w2rd (w);
 #endif
@@ -0,0 +1,119 @@
+#include "analyze.h"
+#include "assume.h"
+#include "decide.h"
+#include "inline.h"
+#include "inlineframes.h"
+
+static void
+analyze_failed_assumption (kissat * solver, unsigned failed)
+{
+  const unsigned level = solver->level;
+  assert (level < SIZE_STACK (solver->assumptions));
+  assert (PEEK_STACK (solver->assumptions, level) == failed);
+  assert (VALUE (failed) < 0);
+
+  LOG ("analyzing failed assumption %s", LOGLIT (failed));
+
+  ints *core = &solver->failed;
+  assert (EMPTY_STACK (*core));
+  PUSH_STACK (*core, PEEK_STACK (solver->assumed, level));
+
+  assigned *all_assigned = solver->assigned;
+  const unsigned failed_idx = IDX (failed);
+  if (!all_assigned[failed_idx].level)
+    {
+      LOG ("failed assumption %s falsified on root level", LOGLIT (failed));
+      return;
+    }
+
+  assert (EMPTY_STACK (solver->analyzed));
+  kissat_push_analyzed (solver, all_assigned, failed_idx);
+  unsigned unresolved = 1;
+
+  const unsigned *t = END_ARRAY (solver->trail);
+  while (unresolved)
+    {
+      assert (t > BEGIN_ARRAY (solver->trail));
+      const unsigned lit = *--t;
+      const unsigned idx = IDX (lit);
+      assigned *a = all_assigned + idx;
+      if (!a->analyzed)
+	continue;
+      assert (unresolved > 0);
+      unresolved--;
+      assert (a->level > 0);
+      assert (a->reason != UNIT_REASON);
+      if (a->reason == DECISION_REASON)
+	{
+	  assert (a->level <= level);
+	  assert (FRAME (a->level).decision == lit);
+	  const int elit = PEEK_STACK (solver->assumed, a->level - 1);
+	  LOG ("assumption %s (external %d) failed too", LOGLIT (lit), elit);
+	  PUSH_STACK (*core, elit);
+	}
+      else if (a->binary)
+	{
+	  const unsigned other = a->reason;
+	  const unsigned other_idx = IDX (other);
+	  assigned *b = all_assigned + other_idx;
+	  if (b->level && !b->analyzed)
+	    {
+	      kissat_push_analyzed (solver, all_assigned, other_idx);
+	      unresolved++;
+	    }
+	}
+      else
+	{
+	  const reference ref = a->reason;
+	  LOGREF (ref, "resolving %s reason", LOGLIT (lit));
+	  clause *reason = kissat_dereference_clause (solver, ref);
+	  for (all_literals_in_clause (other, reason))
+	    {
+	      if (other == lit)
+		continue;
+	      const unsigned other_idx = IDX (other);
+	      assigned *b = all_assigned + other_idx;
+	      if (!b->level || b->analyzed)
+		continue;
+	      kissat_push_analyzed (solver, all_assigned, other_idx);
+	      unresolved++;
+	    }
+	}
+    }
+
+  kissat_reset_only_analyzed_literals (solver);
+  LOG ("found %zu failed assumptions", SIZE_STACK (*core));
+}
+
+int
+kissat_decide_assumption (kissat * solver)
+{
+  assert (kissat_assuming (solver));
+  const unsigned lit = PEEK_STACK (solver->assumptions, solver->level);
+  const value value = VALUE (lit);
+  if (value < 0)
+    {
+      analyze_failed_assumption (solver, lit);
+      return 20;
+    }
+  if (value > 0)
+    {
+      solver->level++;
+      kissat_push_frame (solver, lit);
+      LOG ("pseudo decision level %u for satisfied assumption %s",
+	   solver->level, LOGLIT (lit));
+    }
+  else
+    kissat_internal_assume (solver, lit);
+  return 0;
+}
+
+void
+kissat_reset_assumptions (kissat * solver)
+{
+  LOG ("resetting %zu assumptions", SIZE_STACK (solver->assumptions));
+  for (all_stack (unsigned, lit, solver->assumptions))
+    solver->frozen[IDX (lit)] = false;
+  CLEAR_STACK (solver->assumptions);
+  CLEAR_STACK (solver->assumed);
+}
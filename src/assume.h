@@ -0,0 +1,27 @@
+#ifndef _assume_h_INCLUDED
+#define _assume_h_INCLUDED
+
+#include "internal.h"
+
+// The first 'SIZE_STACK (solver->assumptions)' decision levels are
+// reserved for assumptions.  An assumption which is already satisfied
+// still gets its own (pseudo) decision level without assigning anything,
+// so that the assumption assigned on level 'i + 1' is always the 'i'-th.
+
+static inline bool
+kissat_assuming (kissat * solver)
+{
+  return solver->level < SIZE_STACK (solver->assumptions);
+}
+
+static inline unsigned
+kissat_assumption_levels (kissat * solver)
+{
+  const size_t assumptions = SIZE_STACK (solver->assumptions);
+  return solver->level < assumptions ? solver->level : assumptions;
+}
+
+int kissat_decide_assumption (kissat *);
+void kissat_reset_assumptions (kissat *);
+
+#endif
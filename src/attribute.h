@@ -4,4 +4,7 @@
 #define ATTRIBUTE_FORMAT(FORMAT_POSITION,VARIADIC_ARGUMENT_POSITION) \
   __attribute__ ((format (printf, FORMAT_POSITION, VARIADIC_ARGUMENT_POSITION)))
 
+#define ATTRIBUTE_TARGET(TARGET) \
+  __attribute__ ((target (TARGET)))
+
 #endif
@@ -173,7 +173,7 @@ backbone_assign (kissat * solver, unsigned_array * trail,
 }
 
 static inline clause *
-backbone_propagate_literal (kissat * solver, const bool stop_early,
+backbone_propagate_literal (kissat * solver,
 			    const watches * const all_watches,
 			    unsigned_array * trail, value * values,
 			    assigned * assigned, unsigned lit)
@@ -213,19 +213,11 @@ backbone_propagate_literal (kissat * solver, const bool stop_early,
 	}
       else
 	{
-	  if (stop_early)
-	    {
 #ifndef NDEBUG
-	      for (const union watch * q = p + 1; q != end_watches; q++)
-		{
-		  const union watch watch = *q++;
-		  assert (!watch.type.binary);
-		}
+	  for (const union watch * q = p; q != end_watches; q++)
+	    assert (!q->type.binary);
 #endif
-	      break;
-	    }
-
-	  p++;
+	  break;
 	}
     }
 
@@ -239,8 +231,6 @@ static inline clause *
 backbone_propagate (kissat * solver, unsigned_array * trail,
 		    value * values, assigned * assigned)
 {
-  const bool stop_early = solver->large_clauses_watched_after_binary_clauses;
-
   clause *conflict = 0;
   solver->ticks = 0;
 
@@ -248,7 +238,7 @@ backbone_propagate (kissat * solver, unsigned_array * trail,
   unsigned *propagate = solver->propagate;
 
   while (!conflict && propagate != END_ARRAY (*trail))
-    conflict = backbone_propagate_literal (solver, stop_early, watches, trail,
+    conflict = backbone_propagate_literal (solver, watches, trail,
 					   values, assigned, *propagate++);
 
   assert (solver->propagate <= propagate);
@@ -360,8 +350,7 @@ static unsigned
 compute_backbone (kissat * solver)
 {
 #ifndef NDEBUG
-  if (solver->large_clauses_watched_after_binary_clauses)
-    check_large_clauses_watched_after_binary_clauses (solver);
+  check_large_clauses_watched_after_binary_clauses (solver);
 #endif
   size_t failed = 0;
   unsigneds units;
@@ -18,8 +18,10 @@ void
 kissat_check_satisfying_assignment (kissat * solver)
 {
   LOG ("checking satisfying assignment");
-  const int *const begin = BEGIN_STACK (solver->original);
-  const int *const end = END_STACK (solver->original);
+  const ints *const original =
+    PORTFOLIO ? &solver->portfolio.formula : &solver->original;
+  const int *const begin = BEGIN_STACK (*original);
+  const int *const end = END_STACK (*original);
 #ifdef LOGGING
   size_t count = 0;
 #endif
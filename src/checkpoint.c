@@ -0,0 +1,527 @@
+#include "allocate.h"
+#include "checkpoint.h"
+#include "error.h"
+#include "inline.h"
+#include "logging.h"
+#include "print.h"
+#include "require.h"
+#include "resize.h"
+#include "resources.h"
+#include "utilities.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+// A checkpoint is a plain dump of the state of the solver, i.e., the
+// clause arena and its table of cold clause metadata, the watches in the
+// vectors store, the variable mapping and the extension stack, all
+// per-variable data (flags, values, phases, the VMTF queue links and the
+// scores heap), the trail, the variables remaining to be swept, limits,
+// averages and statistics.  Thus the restored solver resumes search with
+// all learned clauses, scores and phases.  Since the dump is binary it is
+// only compatible with the same build of the solver, which we check
+// through the 'kissat_id' and 'kissat_compiler' strings and the size of
+// the solver structure at the start of the file.  Temporary stacks used
+// during analysis and inprocessing are empty in between search steps and
+// thus skipped.  Options and the proof are not part of the checkpoint and
+// neither are the conflict, decision and memory limits set through the
+// API.  Those limits and the 'limited' flags are kept from the solver
+// restored into.
+
+#define CHECKPOINT_MAGIC "kissat checkpoint"
+#define CHECKPOINT_CONFLICTS 1000
+
+typedef struct checkpointer checkpointer;
+
+struct checkpointer
+{
+  kissat *solver;
+  FILE *file;
+  bool writing;
+  const char *error;
+};
+
+static void
+transfer_bytes (checkpointer * checkpointer, void *ptr, size_t bytes)
+{
+  if (checkpointer->error || !bytes)
+    return;
+  size_t transferred;
+  if (checkpointer->writing)
+    transferred = fwrite (ptr, 1, bytes, checkpointer->file);
+  else
+    transferred = fread (ptr, 1, bytes, checkpointer->file);
+  if (transferred == bytes)
+    return;
+  checkpointer->error = checkpointer->writing ? "write error" :
+    feof (checkpointer->file) ? "truncated file" : "read error";
+}
+
+#define TRANSFER(FIELD) \
+  transfer_bytes (checkpointer, &(FIELD), sizeof (FIELD))
+
+#define TRANSFER_ARRAY(PTR,ELEMENTS) \
+  transfer_bytes (checkpointer, (PTR), (ELEMENTS) * sizeof *(PTR))
+
+#define TRANSFER_STACK(S) \
+  transfer_stack (checkpointer, (chars *) &(S), sizeof *(S).begin)
+
+static void
+transfer_stack (checkpointer * checkpointer, chars * stack,
+		size_t element_bytes)
+{
+  uint64_t bytes = SIZE_STACK (*stack);
+  TRANSFER (bytes);
+  if (checkpointer->error)
+    return;
+  if (!checkpointer->writing)
+    {
+      kissat *solver = checkpointer->solver;
+      const size_t old_capacity = CAPACITY_STACK (*stack);
+      size_t new_capacity = 0;
+      if (bytes)
+	{
+	  new_capacity = element_bytes;
+	  while (new_capacity < bytes || !kissat_aligned_word (new_capacity))
+	    new_capacity *= 2;
+	}
+      stack->begin = kissat_realloc (solver, stack->begin,
+				     old_capacity, new_capacity);
+      stack->end = stack->begin + bytes;
+      stack->allocated = stack->begin + new_capacity;
+    }
+  transfer_bytes (checkpointer, stack->begin, bytes);
+}
+
+static void
+transfer_signature (checkpointer * checkpointer, const char *signature)
+{
+  const uint64_t expected = strlen (signature);
+  uint64_t size = expected;
+  TRANSFER (size);
+  if (checkpointer->error)
+    return;
+  if (checkpointer->writing)
+    {
+      transfer_bytes (checkpointer, (char *) signature, size);
+      return;
+    }
+  if (size != expected)
+    {
+      checkpointer->error = "incompatible build";
+      return;
+    }
+  for (uint64_t i = 0; !checkpointer->error && i < size; i++)
+    {
+      char ch;
+      TRANSFER (ch);
+      if (!checkpointer->error && ch != signature[i])
+	checkpointer->error = "incompatible build";
+    }
+}
+
+static void
+transfer_header (checkpointer * checkpointer)
+{
+  transfer_signature (checkpointer, CHECKPOINT_MAGIC);
+  transfer_signature (checkpointer, kissat_id ());
+  transfer_signature (checkpointer, kissat_compiler ());
+  uint64_t bytes = sizeof (struct kissat);
+  TRANSFER (bytes);
+  if (!checkpointer->error && bytes != sizeof (struct kissat))
+    checkpointer->error = "incompatible build";
+}
+
+static void
+transfer_smooth (checkpointer * checkpointer, smooth * smooth,
+		 const char *name)
+{
+  TRANSFER (smooth->value);
+  TRANSFER (smooth->biased);
+  TRANSFER (smooth->alpha);
+  TRANSFER (smooth->beta);
+  TRANSFER (smooth->exp);
+#ifdef LOGGING
+  TRANSFER (smooth->updated);
+  if (!checkpointer->writing)
+    smooth->name = name;
+#else
+  (void) name;
+#endif
+}
+
+#define TRANSFER_SMOOTH(NAME) \
+  transfer_smooth (checkpointer, &averages->NAME, #NAME)
+
+static void
+transfer_averages (checkpointer * checkpointer, averages * averages)
+{
+  TRANSFER (averages->initialized);
+#ifndef QUIET
+  TRANSFER_SMOOTH (level);
+  TRANSFER_SMOOTH (size);
+  TRANSFER_SMOOTH (trail);
+#endif
+  TRANSFER_SMOOTH (fast_glue);
+  TRANSFER_SMOOTH (slow_glue);
+  TRANSFER_SMOOTH (decision_rate);
+  TRANSFER (averages->saved_decisions);
+}
+
+static void
+transfer_variables (checkpointer * checkpointer)
+{
+  kissat *solver = checkpointer->solver;
+  unsigned size = solver->size;
+  TRANSFER (solver->vars);
+  TRANSFER (size);
+  TRANSFER (solver->active);
+  if (checkpointer->error)
+    return;
+  if (!checkpointer->writing)
+    kissat_increase_size (solver, size);
+  assert (solver->size == size);
+
+  TRANSFER_ARRAY (solver->assigned, size);
+  TRANSFER_ARRAY (solver->flags, size);
+  TRANSFER_ARRAY (solver->frozen, size);
+  TRANSFER_ARRAY (solver->links, size);
+
+  TRANSFER_ARRAY (solver->marks, 2 * (size_t) size);
+  TRANSFER_ARRAY (solver->values, 2 * (size_t) size);
+
+  TRANSFER_ARRAY (solver->phases.best, size);
+  TRANSFER_ARRAY (solver->phases.saved, size);
+  TRANSFER_ARRAY (solver->phases.target, size);
+
+  heap *scores = &solver->scores;
+  unsigned heap_size = scores->size;
+  TRANSFER (scores->tainted);
+  TRANSFER (scores->vars);
+  TRANSFER (heap_size);
+  if (checkpointer->error)
+    return;
+  if (!checkpointer->writing)
+    kissat_resize_heap (solver, scores, heap_size);
+  TRANSFER_STACK (scores->stack);
+  TRANSFER_ARRAY (scores->score, heap_size);
+  TRANSFER_ARRAY (scores->pos, heap_size);
+  TRANSFER (solver->scinc);
+  TRANSFER (solver->queue);
+}
+
+static void
+transfer_trail (checkpointer * checkpointer)
+{
+  kissat *solver = checkpointer->solver;
+  unsigned *const begin = BEGIN_ARRAY (solver->trail);
+  uint64_t size = SIZE_ARRAY (solver->trail);
+  uint64_t propagated = solver->propagate - begin;
+  TRANSFER (size);
+  TRANSFER (propagated);
+  if (checkpointer->error)
+    return;
+  if (size > solver->size || propagated > size)
+    {
+      checkpointer->error = "corrupted trail";
+      return;
+    }
+  TRANSFER_ARRAY (begin, size);
+  solver->trail.end = begin + size;
+  solver->propagate = begin + propagated;
+  TRANSFER (solver->level);
+  TRANSFER_STACK (solver->frames);
+  TRANSFER (solver->best_assigned);
+  TRANSFER (solver->target_assigned);
+  TRANSFER (solver->unflushed);
+  TRANSFER (solver->unassigned);
+}
+
+static void
+transfer_clauses (checkpointer * checkpointer)
+{
+  kissat *solver = checkpointer->solver;
+  ACCOUNT (arena, TRANSFER_STACK (solver->arena));
+  ACCOUNT (arena, TRANSFER_STACK (solver->colds));
+  if (!checkpointer->error &&
+      SIZE_STACK (solver->colds) != SIZE_STACK (solver->arena))
+    {
+      checkpointer->error = "corrupted clauses";
+      return;
+    }
+  TRANSFER (solver->first_reducible);
+  TRANSFER (solver->last_irredundant);
+  TRANSFER (solver->conflict);
+  ACCOUNT (vectors, TRANSFER_STACK (solver->vectors.stack));
+  TRANSFER (solver->vectors.usable);
+  if (checkpointer->error)
+    return;
+  const size_t lits = 2 * (size_t) solver->size;
+#ifdef COMPACT
+  TRANSFER_ARRAY (solver->watches, lits);
+#else
+  unsigned *const base = BEGIN_STACK (solver->vectors.stack);
+  for (size_t lit = 0; lit < lits; lit++)
+    {
+      watches *watches = solver->watches + lit;
+      uint64_t offset = UINT64_MAX;
+      if (watches->begin)
+	offset = watches->begin - base;
+      uint64_t size = watches->end - watches->begin;
+      TRANSFER (offset);
+      TRANSFER (size);
+      if (checkpointer->error)
+	return;
+      if (checkpointer->writing)
+	continue;
+      if (offset == UINT64_MAX)
+	watches->begin = watches->end = 0;
+      else if (offset + size > SIZE_STACK (solver->vectors.stack))
+	{
+	  checkpointer->error = "corrupted watches";
+	  return;
+	}
+      else
+	{
+	  watches->begin = base + offset;
+	  watches->end = watches->begin + size;
+	}
+    }
+#endif
+}
+
+static void
+transfer_statistics (checkpointer * checkpointer)
+{
+  kissat *solver = checkpointer->solver;
+#ifdef METRICS
+  // Memory usage is accounted for by this process though.
+  const uint64_t allocated_current = solver->statistics.allocated_current;
+  const uint64_t allocated_max = solver->statistics.allocated_max;
+#endif
+  TRANSFER (solver->statistics);
+#ifdef METRICS
+  solver->statistics.allocated_current = allocated_current;
+  solver->statistics.allocated_max = allocated_max;
+#endif
+}
+
+static void
+transfer_checkpoint (checkpointer * checkpointer)
+{
+  kissat *solver = checkpointer->solver;
+  transfer_header (checkpointer);
+
+  TRANSFER (solver->extended);
+  TRANSFER (solver->inconsistent);
+  TRANSFER (solver->iterating);
+  TRANSFER (solver->stable);
+  TRANSFER (solver->watching);
+
+  TRANSFER_STACK (solver->export);
+  TRANSFER_STACK (solver->units);
+  TRANSFER_STACK (solver->import);
+  ACCOUNT (extend, TRANSFER_STACK (solver->extend));
+  TRANSFER_STACK (solver->witness);
+  TRANSFER_STACK (solver->eliminated);
+  TRANSFER_STACK (solver->etrail);
+  TRANSFER_STACK (solver->sweep);
+
+  TRANSFER_STACK (solver->assumptions);
+  TRANSFER_STACK (solver->assumed);
+  TRANSFER_STACK (solver->failed);
+  TRANSFER_STACK (solver->restored);
+
+  transfer_variables (checkpointer);
+  transfer_trail (checkpointer);
+  transfer_clauses (checkpointer);
+
+  TRANSFER (solver->random);
+  transfer_averages (checkpointer, &solver->averages[0]);
+  transfer_averages (checkpointer, &solver->averages[1]);
+  TRANSFER (solver->reluctant);
+  TRANSFER (solver->bounds);
+  TRANSFER (solver->delays);
+  TRANSFER (solver->enabled);
+  TRANSFER (solver->last);
+  TRANSFER (solver->limits);
+  TRANSFER (solver->waiting);
+  TRANSFER (solver->walked);
+  transfer_statistics (checkpointer);
+  TRANSFER (solver->mode);
+  TRANSFER (solver->ticks);
+
+#if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
+  TRANSFER_STACK (solver->original);
+  TRANSFER (solver->offset_of_last_original_clause);
+#endif
+}
+
+static bool
+write_checkpoint (kissat * solver, const char *path)
+{
+  const size_t len = strlen (path);
+  char *tmp = kissat_malloc (solver, len + 5);
+  sprintf (tmp, "%s.tmp", path);
+  checkpointer checkpointer;
+  checkpointer.solver = solver;
+  checkpointer.writing = true;
+  checkpointer.error = 0;
+  checkpointer.file = fopen (tmp, "wb");
+  if (checkpointer.file)
+    {
+      transfer_checkpoint (&checkpointer);
+      if (fclose (checkpointer.file) && !checkpointer.error)
+	checkpointer.error = "write error";
+      if (!checkpointer.error && rename (tmp, path))
+	checkpointer.error = "could not rename temporary file";
+      if (checkpointer.error)
+	remove (tmp);
+    }
+  else
+    checkpointer.error = "could not open file";
+  kissat_free (solver, tmp, len + 5);
+  if (checkpointer.error)
+    {
+      kissat_warning (solver, "failed to write checkpoint '%s' (%s)",
+		      path, checkpointer.error);
+      return false;
+    }
+  INC (checkpoints);
+  kissat_phase (solver, "checkpoint", GET (checkpoints),
+		"wrote checkpoint '%s' after %" PRIu64 " conflicts",
+		path, CONFLICTS);
+  return true;
+}
+
+#ifndef NDEBUG
+
+static void
+restore_checker (kissat * solver)
+{
+  if (GET_OPTION (check) < 2)
+    return;
+  for (all_literals (lit))
+    if (kissat_fixed (solver, lit) > 0)
+      kissat_add_unchecked_internal (solver, 1, &lit);
+  for (all_literals (lit))
+    for (all_binary_blocking_watches (watch, WATCHES (lit)))
+      if (watch.type.binary && lit < watch.binary.lit)
+	{
+	  unsigned lits[2] = { lit, watch.binary.lit };
+	  kissat_add_unchecked_internal (solver, 2, lits);
+	}
+  for (all_clauses (c))
+    if (!c->garbage)
+      kissat_add_unchecked_internal (solver, c->size, c->lits);
+}
+
+#endif
+
+int
+kissat_checkpoint (kissat * solver, const char *path)
+{
+  kissat_require_initialized (solver);
+  kissat_require (path, "zero path argument");
+  kissat_require (!PORTFOLIO, "can not checkpoint with threads");
+  kissat_require (EMPTY_STACK (solver->clause),
+		  "incomplete clause (terminating zero not added)");
+  return write_checkpoint (solver, path);
+}
+
+int
+kissat_restore (kissat * solver, const char *path)
+{
+  kissat_require_initialized (solver);
+  kissat_require (path, "zero path argument");
+  kissat_require (!solver->size && !GET (searches),
+		  "can only restore into a new solver");
+  kissat_require (!PORTFOLIO, "can not restore with threads");
+#ifndef NPROOFS
+  kissat_require (!solver->proof, "can not restore while writing a proof");
+#endif
+  checkpointer checkpointer;
+  checkpointer.solver = solver;
+  checkpointer.writing = false;
+  checkpointer.error = 0;
+  checkpointer.file = fopen (path, "rb");
+  const limits fresh = solver->limits;
+  if (checkpointer.file)
+    {
+      transfer_checkpoint (&checkpointer);
+      if (!checkpointer.error && getc (checkpointer.file) != EOF)
+	checkpointer.error = "trailing garbage";
+      fclose (checkpointer.file);
+    }
+  else
+    checkpointer.error = "could not open file";
+  if (checkpointer.error)
+    {
+      kissat_warning (solver, "failed to restore checkpoint '%s' (%s)",
+		      path, checkpointer.error);
+      return 0;
+    }
+  solver->limits.conflicts = fresh.conflicts + CONFLICTS;
+  solver->limits.decisions = fresh.decisions + DECISIONS;
+  solver->limits.memory = fresh.memory;
+  solver->limits.reclaim = fresh.reclaim;
+#ifndef QUIET
+  solver->mode.entered = kissat_process_time ();
+#endif
+#ifndef NDEBUG
+  restore_checker (solver);
+#endif
+  kissat_phase (solver, "restore", GET (checkpoints),
+		"restored checkpoint '%s' after %" PRIu64 " conflicts",
+		path, CONFLICTS);
+  return 1;
+}
+
+void
+kissat_set_checkpoint (kissat * solver, const char *path, double seconds)
+{
+  kissat_require_initialized (solver);
+  kissat_require (path, "zero path argument");
+  kissat_require (seconds > 0, "invalid checkpoint interval %g", seconds);
+  kissat_require (!PORTFOLIO, "can not checkpoint with threads");
+  kissat_release_checkpoint (solver);
+  checkpoint *checkpoint = &solver->checkpoint;
+  const size_t bytes = strlen (path) + 1;
+  checkpoint->path = kissat_malloc (solver, bytes);
+  memcpy (checkpoint->path, path, bytes);
+  checkpoint->interval = seconds;
+  checkpoint->next = kissat_wall_clock_time () + seconds;
+  checkpoint->conflicts = CONFLICTS + CHECKPOINT_CONFLICTS;
+  LOG ("checkpointing to '%s' every %g seconds", path, seconds);
+}
+
+void
+kissat_release_checkpoint (kissat * solver)
+{
+  checkpoint *checkpoint = &solver->checkpoint;
+  if (!checkpoint->path)
+    return;
+  kissat_free (solver, checkpoint->path, strlen (checkpoint->path) + 1);
+  checkpoint->path = 0;
+}
+
+bool
+kissat_checkpointing (kissat * solver)
+{
+  const checkpoint *const checkpoint = &solver->checkpoint;
+  return checkpoint->path && CONFLICTS >= checkpoint->conflicts;
+}
+
+void
+kissat_checkpoint_search (kissat * solver)
+{
+  checkpoint *checkpoint = &solver->checkpoint;
+  assert (checkpoint->path);
+  checkpoint->conflicts = CONFLICTS + CHECKPOINT_CONFLICTS;
+  const double now = kissat_wall_clock_time ();
+  if (now < checkpoint->next)
+    return;
+  checkpoint->next = now + checkpoint->interval;
+  write_checkpoint (solver, checkpoint->path);
+}
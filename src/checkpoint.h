@@ -0,0 +1,23 @@
+#ifndef _checkpoint_h_INCLUDED
+#define _checkpoint_h_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct checkpoint checkpoint;
+
+struct checkpoint
+{
+  char *path;
+  double interval;
+  double next;
+  uint64_t conflicts;
+};
+
+struct kissat;
+
+bool kissat_checkpointing (struct kissat *);
+void kissat_checkpoint_search (struct kissat *);
+void kissat_release_checkpoint (struct kissat *);
+
+#endif
@@ -29,7 +29,7 @@ static void
 init_clause (kissat * solver, clause * res,
 	     bool redundant, unsigned glue, unsigned size)
 {
-  assert (size <= UINT_MAX);
+  assert (size < (1u << LD_MAX_VAR));
   assert (redundant || !glue);
 
   glue = MIN (MAX_GLUE, glue);
@@ -37,24 +37,25 @@ init_clause (kissat * solver, clause * res,
   const unsigned tier1 = GET_OPTION (tier1);
   const bool keep = (glue <= tier1);
 
-  res->glue = glue;
-
+  res->searched = 2;
   res->garbage = false;
   res->keep = keep;
   res->reason = false;
+
+  res->size = size;
   res->redundant = redundant;
-  res->shrunken = false;
-  res->subsume = false;
-  res->sweeped = false;
-  res->vivify = false;
+  res->shared = false;
 
-  res->used = 0;
+  cold *cold = COLD (res);
 
-  res->searched = 2;
-  res->size = size;
-#ifdef NOPTIONS
-  (void) solver;
-#endif
+  cold->glue = glue;
+
+  cold->shrunken = false;
+  cold->subsume = false;
+  cold->sweeped = false;
+  cold->vivify = false;
+
+  cold->used = 0;
 }
 
 void
@@ -100,7 +101,7 @@ new_large_clause (kissat * solver,
   memcpy (c->lits, lits, size * sizeof (unsigned));
   LOGREF (res, "new");
   if (solver->watching)
-    kissat_watch_reference (solver, lits[0], lits[1], res);
+    kissat_watch_clause (solver, c);
   else
     kissat_connect_clause (solver, c);
   if (redundant)
@@ -187,7 +188,7 @@ kissat_mark_clause_as_garbage (kissat * solver, clause * c)
 {
   assert (!c->garbage);
   mark_clause_as_garbage (solver, c);
-  size_t bytes = kissat_actual_bytes_of_clause (c);
+  size_t bytes = kissat_actual_bytes_of_clause (solver, c);
   ADD (arena_garbage, bytes);
 }
 
@@ -197,7 +198,7 @@ kissat_delete_clause (kissat * solver, clause * c)
   LOGCLS (c, "delete");
   assert (c->size > 2);
   assert (c->garbage);
-  size_t bytes = kissat_actual_bytes_of_clause (c);
+  size_t bytes = kissat_actual_bytes_of_clause (solver, c);
   SUB (arena_garbage, bytes);
   INC (clauses_deleted);
   return (clause *) ((char *) c + bytes);
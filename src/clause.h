@@ -9,32 +9,52 @@
 #include <stdbool.h>
 
 typedef struct clause clause;
+typedef struct cold cold;
 
-#define LD_MAX_GLUE 22u
+#define LD_MAX_GLUE 21u
 #define MAX_GLUE ((1u<<LD_MAX_GLUE)-1)
 
+// The clause header in the arena only holds the data needed during
+// propagation and conflict analysis, which keeps it at two words and thus
+// more clauses fit into a cache line.  Since clause sizes and positions
+// are bounded by the number of variables, the remaining flags fit into
+// the same two words.  Metadata only needed for reduction and
+// inprocessing is kept in a separate 'cold' table indexed by clause
+// reference (see 'COLD' in 'internal.h').
+
 struct clause
 {
-  unsigned glue:LD_MAX_GLUE;
-
+  unsigned searched:LD_MAX_VAR;
   bool garbage:1;
   bool keep:1;
   bool reason:1;
+
+  unsigned size:LD_MAX_VAR;
   bool redundant:1;
+  bool shared:1;
+
+  unsigned lits[3];
+};
+
+struct cold
+{
+  unsigned glue:LD_MAX_GLUE;
+
   bool shrunken:1;
   bool subsume:1;
   bool sweeped:1;
   bool vivify:1;
 
   unsigned used:2;
+};
 
-  unsigned searched;
-  unsigned size;
+// *INDENT-OFF*
 
-  unsigned lits[3];
-};
+typedef STACK (cold) colds;
 
-#define SIZE_OF_CLAUSE_HEADER ((size_t) &((clause*)0)->searched)
+// *INDENT-ON*
+
+#define SIZE_OF_CLAUSE_HEADER ((size_t) &((clause*)0)->lits)
 
 #define BEGIN_LITS(C) ((C)->lits)
 #define END_LITS(C) (BEGIN_LITS (C) + (C)->size)
@@ -52,23 +72,6 @@ kissat_bytes_of_clause (unsigned size)
   return kissat_align_ward (res);
 }
 
-static inline size_t
-kissat_actual_bytes_of_clause (clause * c)
-{
-  unsigned const *p = END_LITS (c);
-  if (c->shrunken)
-    while (*p++ != INVALID_LIT)
-      ;
-  return kissat_align_ward ((char *) p - (char *) c);
-}
-
-static inline clause *
-kissat_next_clause (clause * c)
-{
-  word bytes = kissat_actual_bytes_of_clause (c);
-  return (clause *) ((char *) c + bytes);
-}
-
 struct kissat;
 
 void kissat_new_binary_clause (struct kissat *,
@@ -14,7 +14,7 @@
 #include <string.h>
 
 static void
-flush_watched_clauses_by_literal (kissat * solver,
+flush_watched_clauses_by_literal (kissat * solver, watches * compacted,
 				  unsigned lit, bool compact, reference start)
 {
   assert (start != INVALID_REF);
@@ -70,6 +70,7 @@ flush_watched_clauses_by_literal (kissat * solver,
 	{
 	  assert (solver->watching);
 	  const watch tail = *p++;
+	  const watch third = head.type.ternary ? *p++ : head;
 	  if (!lit_fixed)
 	    {
 	      const reference ref = tail.large.ref;
@@ -77,6 +78,8 @@ flush_watched_clauses_by_literal (kissat * solver,
 		{
 		  *q++ = head;
 		  *q++ = tail;
+		  if (head.type.ternary)
+		    *q++ = third;
 		}
 	    }
 	}
@@ -94,23 +97,12 @@ flush_watched_clauses_by_literal (kissat * solver,
   if (mlit == INVALID_LIT)
     return;
 
-  watches *mlit_watches = &WATCHES (mlit);
-#if defined(LOGGING) || !defined(NDEBUG)
-  const size_t size_mlit_watches = SIZE_WATCHES (*mlit_watches);
-#endif
   if (lit_fixed)
-    assert (!size_mlit_watches);
-  else if (mlit < lit)
-    {
-      assert (mlit != INVALID_LIT);
-      assert (mlit < lit);
-      *mlit_watches = *lit_watches;
-      LOG ("copied watches[%u] = watches[%u] (size %zu)",
-	   mlit, lit, size_mlit_watches);
-      memset (lit_watches, 0, sizeof *lit_watches);
-    }
-  else
-    assert (mlit == lit);
+    return;
+
+  compacted[mlit] = *lit_watches;
+  LOG ("copied watches[%u] = watches[%u] (size %zu)",
+       mlit, lit, size_lit_watches);
 }
 
 static void
@@ -118,13 +110,24 @@ flush_all_watched_clauses (kissat * solver, bool compact, reference start)
 {
   assert (solver->watching);
   LOG ("starting to flush watches at clause[%" REFERENCE_FORMAT "]", start);
+  const size_t size = 2 * (size_t) solver->size;
+  watches *compacted = 0;
+  if (compact)
+    ACCOUNT (variables, CALLOC (compacted, size));
   for (all_variables (idx))
     {
       const unsigned lit = LIT (idx);
-      flush_watched_clauses_by_literal (solver, lit, compact, start);
+      flush_watched_clauses_by_literal (solver, compacted,
+					lit, compact, start);
       const unsigned not_lit = NOT (lit);
-      flush_watched_clauses_by_literal (solver, not_lit, compact, start);
+      flush_watched_clauses_by_literal (solver, compacted,
+					not_lit, compact, start);
     }
+  if (!compact)
+    return;
+  ACCOUNT (variables, DEALLOC (solver->watches, size));
+  solver->watches = compacted;
+  kissat_release_defrag_vectors (solver);
 }
 
 static void
@@ -233,6 +236,9 @@ move_redundant_clauses_to_the_end (kissat * solver, reference ref)
 		FORMAT_BYTES (bytes_redundant));
   kissat_mark_reason_clauses (solver, ref);
   clause *redundant = (clause *) kissat_malloc (solver, bytes_redundant);
+  const size_t wards_redundant = bytes_redundant / sizeof (ward);
+  const size_t bytes_colds = wards_redundant * sizeof (cold);
+  cold *colds = kissat_malloc (solver, bytes_colds);
   clause *p = begin, *q = begin, *r = redundant;
 
   const value *const values = solver->values;
@@ -242,17 +248,20 @@ move_redundant_clauses_to_the_end (kissat * solver, reference ref)
 
   while (p != end)
     {
-      assert (!p->shrunken);
+      assert (!COLD (p)->shrunken);
       size_t bytes = kissat_bytes_of_clause (p->size);
       if (p->redundant)
 	{
+	  colds[(ward *) r - (ward *) redundant] = *COLD (p);
 	  memcpy (r, p, bytes);
 	  r = (clause *) (bytes + (char *) r);
 	}
       else
 	{
 	  LOGCLS (p, "old DST");
+	  const cold cold = *COLD (p);
 	  memmove (q, p, bytes);
+	  *COLD (q) = cold;
 	  LOGCLS (q, "new DST");
 	  last_irredundant = q;
 	  if (q->reason)
@@ -267,6 +276,7 @@ move_redundant_clauses_to_the_end (kissat * solver, reference ref)
     {
       size_t bytes = kissat_bytes_of_clause (r->size);
       memcpy (q, r, bytes);
+      *COLD (q) = colds[(ward *) r - (ward *) redundant];
       LOGCLS (q, "new DST");
       if (q->reason)
 	get_forced_and_update_large_reason (solver, assigned, values, q);
@@ -278,6 +288,7 @@ move_redundant_clauses_to_the_end (kissat * solver, reference ref)
     }
   assert ((char *) r <= (char *) redundant + bytes_redundant);
   kissat_free (solver, redundant, bytes_redundant);
+  kissat_free (solver, colds, bytes_colds);
 
   assert (!first_reducible || first_reducible < q);
 
@@ -343,12 +354,12 @@ sparse_sweep_garbage_clauses (kissat * solver, bool compact, reference start)
 
       assert (src->size > 1);
       LOGCLS (src, "SRC");
-      next = kissat_next_clause (src);
+      next = kissat_next_clause (solver, src);
 #if !defined(NDEBUG) || defined(CHECKING_OR_PROVING)
       const unsigned old_size = src->size;
 #endif
-      assert (SIZE_OF_CLAUSE_HEADER == sizeof (unsigned));
-      *(unsigned *) dst = *(unsigned *) src;
+      memmove (dst, src, SIZE_OF_CLAUSE_HEADER);
+      *COLD (dst) = *COLD (src);
 
       unsigned *q = dst->lits;
 
@@ -480,14 +491,14 @@ sparse_sweep_garbage_clauses (kissat * solver, bool compact, reference start)
 	  assert (2 < new_size);
 
 	  dst->size = new_size;
-	  dst->shrunken = false;
 	  dst->searched = 2;
+	  COLD (dst)->shrunken = false;
 
 	  LOGCLS (dst, "DST");
 	  if (dst->reason)
 	    update_large_reason (solver, assigned, forced, dst);
 
-	  clause *next_dst = kissat_next_clause (dst);
+	  clause *next_dst = kissat_next_clause (solver, dst);
 
 	  if (dst->redundant)
 	    {
@@ -611,18 +622,14 @@ rewatch_clauses (kissat * solver, reference start)
 
   for (clause * next; c != end; c = next)
     {
-      next = kissat_next_clause (c);
+      next = kissat_next_clause (solver, c);
 
       unsigned *lits = c->lits;
       kissat_sort_literals (solver, values, assigned, c->size, lits);
       c->searched = 2;
 
       const reference ref = (ward *) c - arena;
-      const unsigned l0 = lits[0];
-      const unsigned l1 = lits[1];
-
-      kissat_push_blocking_watch (solver, watches + l0, l1, ref);
-      kissat_push_blocking_watch (solver, watches + l1, l0, ref);
+      kissat_push_clause_watches (solver, watches, c, ref);
     }
 }
 
@@ -683,19 +690,17 @@ dense_sweep_garbage_clauses (kissat * solver)
 	}
       assert (src->size > 1);
       LOGCLS (src, "SRC");
-      next = kissat_next_clause (src);
-      assert (SIZE_OF_CLAUSE_HEADER == sizeof (unsigned));
-      *(unsigned *) dst = *(unsigned *) src;
-      dst->searched = src->searched;
-      dst->size = src->size;
-      dst->shrunken = false;
+      next = kissat_next_clause (solver, src);
+      memmove (dst, src, SIZE_OF_CLAUSE_HEADER);
+      *COLD (dst) = *COLD (src);
+      COLD (dst)->shrunken = false;
       memmove (dst->lits, src->lits, src->size * sizeof (unsigned));
       LOGCLS (dst, "DST");
       if (!dst->redundant)
 	last_irredundant = dst;
       else if (!first_reducible && !dst->keep)
 	first_reducible = dst;
-      dst = kissat_next_clause (dst);
+      dst = kissat_next_clause (solver, dst);
     }
 
   update_first_reducible (solver, dst, first_reducible);
@@ -12,9 +12,27 @@ kissat_defrag_watches (kissat * solver)
   kissat_defrag_vectors (solver, LITS, solver->watches);
 }
 
+static inline bool
+kissat_defragmenting (kissat * solver)
+{
+  const defrag *defrag = &solver->vectors.defrag;
+  return !EMPTY_STACK (defrag->sorted) && defrag->conflicts < CONFLICTS;
+}
+
+static inline void
+kissat_defrag_watches_step (kissat * solver)
+{
+  solver->vectors.defrag.conflicts = CONFLICTS;
+  kissat_defrag_vectors_step (solver, LITS, solver->watches);
+}
+
 static inline void
 kissat_defrag_watches_if_needed (kissat * solver)
 {
+  const bool incremental = GET_OPTION (defragincr) && solver->watching;
+  if (incremental && !EMPTY_STACK (solver->vectors.defrag.sorted))
+    return;
+
   const size_t size = SIZE_STACK (solver->vectors.stack);
   const size_t size_limit = GET_OPTION (defragsize);
   if (size <= size_limit)
@@ -26,7 +44,10 @@ kissat_defrag_watches_if_needed (kissat * solver)
     return;
 
   INC (vectors_defrags_needed);
-  kissat_defrag_watches (solver);
+  if (incremental)
+    kissat_start_defrag_vectors (solver, LITS, solver->watches);
+  else
+    kissat_defrag_watches (solver);
 }
 
 #endif
@@ -17,6 +17,73 @@ reimport_literal (kissat * solver, unsigned eidx, unsigned mlit)
   import->lit = mlit;
 }
 
+static inline unsigned *
+enqueue_variable (kissat * solver, unsigned *positions,
+		  const unsigned *begin, unsigned *end, unsigned idx)
+{
+  if (!ACTIVE (idx))
+    return end;
+  if (positions[idx] != INVALID_IDX)
+    return end;
+  positions[idx] = end - begin;
+  *end++ = idx;
+  return end;
+}
+
+// Without renumbering compacting keeps the relative order of variables.
+// Then variables occurring together in clauses might end up far apart in
+// all the variable and literal indexed arrays.  Instead we number active
+// variables in breadth-first order of the clause graph (only using the
+// watched clauses), such that neighbors in the graph become close.
+
+static unsigned *
+order_variables (kissat * solver)
+{
+  assert (solver->watching);
+  const unsigned vars = solver->vars;
+  const unsigned active = solver->active;
+  unsigned *positions, *queue;
+  NALLOC (positions, vars);
+  NALLOC (queue, active);
+  for (all_variables (idx))
+    positions[idx] = INVALID_IDX;
+  ward *const arena = BEGIN_STACK (solver->arena);
+  unsigned *search = queue, *end = queue;
+  for (all_variables (root))
+    {
+      end = enqueue_variable (solver, positions, queue, end, root);
+      while (search != end)
+	{
+	  const unsigned idx = *search++;
+	  const unsigned lit = LIT (idx);
+	  for (unsigned sign = 0; sign < 2; sign++)
+	    {
+	      watches *const watches = &WATCHES (lit ^ sign);
+	      reference ref;
+	      for (all_binary_blocking_watch_ref (watch, ref, *watches))
+		{
+		  if (watch.type.binary)
+		    {
+		      const unsigned other = IDX (watch.binary.lit);
+		      end = enqueue_variable (solver, positions,
+					      queue, end, other);
+		      continue;
+		    }
+		  clause *const c = (clause *) (arena + ref);
+		  if (c->garbage)
+		    continue;
+		  for (all_literals_in_clause (other, c))
+		    end = enqueue_variable (solver, positions,
+					    queue, end, IDX (other));
+		}
+	    }
+	}
+    }
+  assert (end == queue + active);
+  DEALLOC (queue, active);
+  return positions;
+}
+
 unsigned
 kissat_compact_literals (kissat * solver, unsigned *mfixed_ptr)
 {
@@ -35,6 +102,9 @@ kissat_compact_literals (kissat * solver, unsigned *mfixed_ptr)
   assert (!solver->compacting);
   solver->compacting = true;
 #endif
+  unsigned *positions = 0;
+  if (GET_OPTION (compactorder) && solver->vars - solver->active > 1)
+    positions = order_variables (solver);
   unsigned mfixed = INVALID_LIT;
   unsigned vars = 0;
   for (all_variables (iidx))
@@ -50,7 +120,7 @@ kissat_compact_literals (kissat * solver, unsigned *mfixed_ptr)
 	  assert (value);
 	  if (mfixed == INVALID_LIT)
 	    {
-	      mlit = mfixed = LIT (vars);
+	      mlit = mfixed = LIT (positions ? solver->active : vars);
 	      LOG2 ("first fixed %u mapped to %u assigned to %d",
 		    ilit, mfixed, value);
 	      if (value < 0)
@@ -72,7 +142,7 @@ kissat_compact_literals (kissat * solver, unsigned *mfixed_ptr)
       else if (flags->active)
 	{
 	  assert (flags->active);
-	  mlit = LIT (vars);
+	  mlit = LIT (positions ? positions[iidx] : vars);
 	  LOG2 ("remapping %u to %u", ilit, mlit);
 	  vars++;
 	}
@@ -93,8 +163,8 @@ kissat_compact_literals (kissat * solver, unsigned *mfixed_ptr)
 	    LOG2 ("skipping inactive %u", ilit);
 	  continue;
 	}
-      assert (mlit <= ilit);
-      assert (mlit != NOT (ilit));
+      assert (positions || mlit <= ilit);
+      assert (positions || mlit != NOT (ilit));
       if (mlit == ilit)
 	continue;
       const int elit = PEEK_STACK (solver->export, iidx);
@@ -103,6 +173,8 @@ kissat_compact_literals (kissat * solver, unsigned *mfixed_ptr)
 	mlit = NOT (mlit);
       reimport_literal (solver, eidx, mlit);
     }
+  if (positions)
+    DEALLOC (positions, solver->vars);
   *mfixed_ptr = mfixed;
   LOG ("compacting to %u variables %.2f%% from %u",
        vars, kissat_percent (vars, solver->vars), solver->vars);
@@ -111,25 +183,63 @@ kissat_compact_literals (kissat * solver, unsigned *mfixed_ptr)
 }
 
 static void
-compact_literal (kissat * solver, unsigned dst_lit, unsigned src_lit)
+compact_variable_indexed (kissat * solver, const unsigned *mlits,
+			  unsigned vars, void *array, size_t bytes)
 {
-  assert (dst_lit < src_lit);
-  assert (dst_lit != NOT (src_lit));
-  const unsigned dst_idx = IDX (dst_lit);
-  const unsigned src_idx = IDX (src_lit);
-  assert (dst_idx != src_idx);
-  LOG ("mapping old internal literal %u to %u", src_lit, dst_lit);
-  solver->assigned[dst_idx] = solver->assigned[src_idx];
-  solver->flags[dst_idx] = solver->flags[src_idx];
-
-  solver->phases.best[dst_idx] = solver->phases.best[src_idx];
-  solver->phases.saved[dst_idx] = solver->phases.saved[src_idx];
-  solver->phases.target[dst_idx] = solver->phases.target[src_idx];
-
-  const unsigned not_src_lit = NOT (src_lit);
-  const unsigned not_dst_lit = NOT (dst_lit);
-  solver->values[dst_lit] = solver->values[src_lit];
-  solver->values[not_dst_lit] = solver->values[not_src_lit];
+  char *const begin = array;
+  char *compacted = kissat_calloc (solver, vars, bytes);
+  for (all_variables (iidx))
+    {
+      const unsigned mlit = mlits[iidx];
+      if (mlit == INVALID_LIT)
+	continue;
+      const unsigned midx = IDX (mlit);
+      assert (midx < vars);
+      memcpy (compacted + midx * bytes, begin + iidx * bytes, bytes);
+    }
+  memcpy (begin, compacted, vars * bytes);
+  kissat_dealloc (solver, compacted, vars, bytes);
+}
+
+#define COMPACT_VARIABLE_INDEXED(ARRAY) \
+  compact_variable_indexed (solver, mlits, vars, \
+                            (ARRAY), sizeof *(ARRAY))
+
+static void
+compact_values (kissat * solver, const unsigned *mlits, unsigned vars)
+{
+  value *values = solver->values;
+  value *compacted;
+  CALLOC (compacted, 2 * vars);
+  for (all_variables (iidx))
+    {
+      const unsigned mlit = mlits[iidx];
+      if (mlit == INVALID_LIT)
+	continue;
+      const unsigned ilit = LIT (iidx);
+      compacted[mlit] = values[ilit];
+      compacted[NOT (mlit)] = values[NOT (ilit)];
+    }
+  memcpy (values, compacted, 2 * vars * sizeof *values);
+  DEALLOC (compacted, 2 * vars);
+}
+
+// Since variables might be renumbered in arbitrary order (and not only
+// moved to smaller indices) variable data is copied to a temporary array.
+
+static void
+compact_variables (kissat * solver, const unsigned *mlits, unsigned vars)
+{
+  LOG ("compacting variables");
+  COMPACT_VARIABLE_INDEXED (solver->assigned);
+  COMPACT_VARIABLE_INDEXED (solver->flags);
+  COMPACT_VARIABLE_INDEXED (solver->frozen);
+
+  COMPACT_VARIABLE_INDEXED (solver->phases.best);
+  COMPACT_VARIABLE_INDEXED (solver->phases.saved);
+  COMPACT_VARIABLE_INDEXED (solver->phases.target);
+
+  compact_values (solver, mlits, vars);
 }
 
 static unsigned
@@ -147,12 +257,11 @@ map_idx (kissat * solver, unsigned iidx)
     return INVALID_IDX;
   const unsigned mlit = import->lit;
   const unsigned midx = IDX (mlit);
-  assert (midx <= iidx);
   return midx;
 }
 
 static void
-compact_queue (kissat * solver)
+compact_queue (kissat * solver, const unsigned *mlits, unsigned vars)
 {
   LOG ("compacting queue");
   links *links = solver->links, *l;
@@ -174,13 +283,7 @@ compact_queue (kissat * solver)
     }
   solver->queue.last = prev;
   *p = DISCONNECT;
-  for (all_variables (idx))
-    {
-      const unsigned midx = map_idx (solver, idx);
-      if (midx == INVALID_IDX)
-	continue;
-      links[midx] = links[idx];
-    }
+  COMPACT_VARIABLE_INDEXED (links);
 }
 
 static void
@@ -276,22 +379,26 @@ compact_frames (kissat * solver)
 }
 
 static void
-compact_export (kissat * solver, unsigned vars)
+compact_assumptions (kissat * solver)
 {
-  LOG ("compacting export");
-  const size_t size = SIZE_STACK (solver->export);
-  assert (size <= UINT_MAX);
-  assert (size == solver->vars);
-  for (unsigned iidx = 0; iidx < size; iidx++)
+  LOG ("compacting assumptions");
+  unsigned *begin = BEGIN_STACK (solver->assumptions);
+  const unsigned *const end = END_STACK (solver->assumptions);
+  for (unsigned *p = begin; p != end; p++)
     {
-      const unsigned elit = PEEK_STACK (solver->export, iidx);
-      if (!elit)
-	continue;
-      const unsigned midx = map_idx (solver, iidx);
-      if (midx == INVALID_IDX)
-	continue;
-      POKE_STACK (solver->export, midx, elit);
+      const unsigned ilit = *p;
+      const unsigned mlit = kissat_map_literal (solver, ilit, true);
+      assert (mlit != INVALID_LIT);
+      *p = mlit;
     }
+}
+
+static void
+compact_export (kissat * solver, const unsigned *mlits, unsigned vars)
+{
+  LOG ("compacting export");
+  assert (SIZE_STACK (solver->export) == solver->vars);
+  COMPACT_VARIABLE_INDEXED (BEGIN_STACK (solver->export));
   RESIZE_STACK (solver->export, vars);
   SHRINK_STACK (solver->export);
 #ifndef NDEBUG
@@ -387,6 +494,9 @@ kissat_finalize_compacting (kissat * solver, unsigned vars, unsigned mfixed)
   unsigned reduced = solver->vars - vars;
   LOG ("compacted number of variables from %u to %u", solver->vars, vars);
 
+  compact_frames (solver);
+  compact_assumptions (solver);
+
   bool first = true;
   for (all_variables (iidx))
     {
@@ -399,28 +509,28 @@ kissat_finalize_compacting (kissat * solver, unsigned vars, unsigned mfixed)
 
   compact_trail (solver);
 
+  unsigned *mlits;
+  NALLOC (mlits, solver->vars);
   for (all_variables (iidx))
-    {
-      const unsigned ilit = LIT (iidx);
-      const unsigned mlit = kissat_map_literal (solver, ilit, true);
-      if (mlit != INVALID_LIT && ilit != mlit)
-	compact_literal (solver, mlit, ilit);
-    }
+    mlits[iidx] = kissat_map_literal (solver, LIT (iidx), true);
+
+  compact_variables (solver, mlits, vars);
 
   if (mfixed != INVALID_LIT)
     compact_units (solver, mfixed);
 
   memset (solver->assigned + vars, 0, reduced * sizeof (assigned));
   memset (solver->flags + vars, 0, reduced * sizeof (flags));
+  memset (solver->frozen + vars, 0, reduced * sizeof (bool));
   memset (solver->values + 2 * vars, 0, 2 * reduced * sizeof (value));
   memset (solver->watches + 2 * vars, 0, 2 * reduced * sizeof (watches));
 
-  compact_queue (solver);
+  compact_queue (solver, mlits, vars);
   compact_sweep (solver);
   compact_scores (solver, SCORES, vars);
-  compact_frames (solver);
-  compact_export (solver, vars);
+  compact_export (solver, mlits, vars);
   compact_best_and_target_values (solver, vars);
+  DEALLOC (mlits, solver->vars);
 
   solver->vars = vars;
 #ifdef LOGGING
@@ -0,0 +1,506 @@
+#include "allocate.h"
+#include "cube.h"
+#include "internal.h"
+#include "lookahead.h"
+#include "print.h"
+#include "resources.h"
+
+#include <inttypes.h>
+#include <limits.h>
+
+#ifdef _POSIX_C_SOURCE
+#include <pthread.h>
+#endif
+
+// Cube-and-conquer is an alternative to the plain portfolio, selected by
+// a positive 'cubes' option.  The first worker simplifies the formula with
+// a limited search ('cubeconflicts') and then splits it by lookahead
+// recursively into up to '2^cubes' cubes, dropping cubes refuted by
+// lookahead already.  The cubes are distributed evenly among the workers,
+// which then solve cubes as assumptions with a conflict limit.  A cube
+// hitting that limit is split by lookahead of the worker into two cubes,
+// which the worker continues with.  If lookahead fails to find a variable
+// to split on, the cube is put back with its conflict limit doubled.  Idle
+// workers steal the oldest cube of another worker.  The first satisfiable
+// cube terminates all workers, while refuting all cubes proves the formula
+// unsatisfiable.  A summary of each solved cube is kept in the portfolio
+// until the next call and printed with the statistics.
+
+typedef struct cube cube;
+typedef struct pool pool;
+typedef struct worker worker;
+
+struct cube
+{
+  unsigned id;
+  unsigned parent;
+  uint64_t limit;
+  ints lits;
+};
+
+// *INDENT-OFF*
+typedef STACK (cube *) cubes;
+// *INDENT-ON*
+
+// Each worker owns a double ended queue of cubes.  It pushes and pops
+// cubes at the end while thieves take cubes starting at 'bottom'.
+
+struct worker
+{
+  kissat *solver;
+  pool *pool;
+  unsigned id;
+  size_t bottom;
+  cubes cubes;
+#ifdef _POSIX_C_SOURCE
+  pthread_t thread;
+  bool started;
+#endif
+};
+
+struct pool
+{
+  kissat *solver;
+  worker *workers;
+  unsigned threads;
+  unsigned busy;
+  unsigned generated;
+  unsigned refuted;
+  unsigned winner;
+  int res;
+  volatile bool done;
+#ifdef _POSIX_C_SOURCE
+  pthread_mutex_t lock;
+  pthread_cond_t wakeup;
+#endif
+};
+
+bool
+kissat_cubing (kissat * solver)
+{
+  if (!GET_OPTION (cubes))
+    return false;
+  if (!EMPTY_STACK (solver->assumed))
+    return false;
+  if (solver->limited.conflicts || solver->limited.decisions)
+    return false;
+  return true;
+}
+
+static void
+lock_pool (pool * pool)
+{
+#ifdef _POSIX_C_SOURCE
+  pthread_mutex_lock (&pool->lock);
+#else
+  (void) pool;
+#endif
+}
+
+static void
+unlock_pool (pool * pool)
+{
+#ifdef _POSIX_C_SOURCE
+  pthread_mutex_unlock (&pool->lock);
+#else
+  (void) pool;
+#endif
+}
+
+static void
+wakeup_workers (pool * pool)
+{
+#ifdef _POSIX_C_SOURCE
+  pthread_cond_broadcast (&pool->wakeup);
+#else
+  (void) pool;
+#endif
+}
+
+static cube *
+new_cube (pool * pool, unsigned parent, uint64_t limit,
+	  size_t size, const int *lits)
+{
+  kissat *solver = pool->solver;
+  cube *res = kissat_malloc (solver, sizeof *res);
+  res->id = pool->generated++;
+  res->parent = parent;
+  res->limit = limit;
+  INIT_STACK (res->lits);
+  for (size_t i = 0; i < size; i++)
+    PUSH_STACK (res->lits, lits[i]);
+  return res;
+}
+
+static void
+delete_cube (pool * pool, cube * cube)
+{
+  kissat *solver = pool->solver;
+  RELEASE_STACK (cube->lits);
+  kissat_free (solver, cube, sizeof *cube);
+}
+
+static void
+push_cube (pool * pool, worker * worker, cube * cube)
+{
+  kissat *solver = pool->solver;
+  PUSH_STACK (worker->cubes, cube);
+}
+
+static cube *
+pop_cube (worker * worker)
+{
+  cubes *cubes = &worker->cubes;
+  if (SIZE_STACK (*cubes) == worker->bottom)
+    return 0;
+  cube *res = POP_STACK (*cubes);
+  if (SIZE_STACK (*cubes) == worker->bottom)
+    {
+      CLEAR_STACK (*cubes);
+      worker->bottom = 0;
+    }
+  return res;
+}
+
+static cube *
+steal_cube (pool * pool, worker * thief)
+{
+  for (unsigned i = 1; i < pool->threads; i++)
+    {
+      worker *victim = pool->workers + (thief->id + i) % pool->threads;
+      cubes *cubes = &victim->cubes;
+      if (SIZE_STACK (*cubes) == victim->bottom)
+	continue;
+      cube *res = PEEK_STACK (*cubes, victim->bottom);
+      if (++victim->bottom == SIZE_STACK (*cubes))
+	{
+	  CLEAR_STACK (*cubes);
+	  victim->bottom = 0;
+	}
+      return res;
+    }
+  return 0;
+}
+
+static void
+generate_cubes (pool * pool, kissat * lookahead, ints * prefix,
+		unsigned depth)
+{
+  kissat *solver = pool->solver;
+  if (solver->termination.flagged)
+    return;
+  int split;
+  if (kissat_lookahead (lookahead, SIZE_STACK (*prefix),
+			BEGIN_STACK (*prefix), &split))
+    {
+      pool->refuted++;
+      return;
+    }
+  if (depth && split)
+    {
+      PUSH_STACK (*prefix, split);
+      generate_cubes (pool, lookahead, prefix, depth - 1);
+      TOP_STACK (*prefix) = -split;
+      generate_cubes (pool, lookahead, prefix, depth - 1);
+      (void) POP_STACK (*prefix);
+      return;
+    }
+  const uint64_t limit = GET_OPTION (cubeconflicts);
+  cube *cube = new_cube (pool, UINT_MAX, limit,
+			 SIZE_STACK (*prefix), BEGIN_STACK (*prefix));
+  worker *worker = pool->workers + cube->id % pool->threads;
+  push_cube (pool, worker, cube);
+}
+
+static cube *
+next_cube (pool * pool, worker * worker)
+{
+  cube *res = 0;
+  lock_pool (pool);
+  for (;;)
+    {
+      if (pool->done)
+	break;
+      if (pool->solver->termination.flagged)
+	{
+	  pool->done = true;
+	  wakeup_workers (pool);
+	  break;
+	}
+      if ((res = pop_cube (worker)) || (res = steal_cube (pool, worker)))
+	{
+	  pool->busy++;
+	  break;
+	}
+      if (!pool->busy)
+	{
+	  pool->res = 20;
+	  pool->winner = worker->id;
+	  pool->done = true;
+	  wakeup_workers (pool);
+	  break;
+	}
+#ifdef _POSIX_C_SOURCE
+      pthread_cond_wait (&pool->wakeup, &pool->lock);
+#endif
+    }
+  unlock_pool (pool);
+  return res;
+}
+
+static void
+finish_cube (pool * pool, worker * worker, cube * cube,
+	     const conquered * conquered)
+{
+  kissat *solver = pool->solver;
+  lock_pool (pool);
+  PUSH_STACK (solver->portfolio.cubes, *conquered);
+  assert (pool->busy);
+  pool->busy--;
+  const int res = conquered->res;
+  const bool inconsistent = worker->solver->inconsistent;
+  if (!pool->done && (res == 10 || (res == 20 && inconsistent)))
+    {
+      pool->res = res;
+      pool->winner = worker->id;
+      pool->done = true;
+      for (unsigned i = 0; i < pool->threads; i++)
+	if (i != worker->id)
+	  kissat_terminate (pool->workers[i].solver);
+    }
+  else if (!pool->done && !res && !conquered->terminated)
+    {
+      const int split = conquered->split;
+      if (split)
+	{
+	  const size_t size = SIZE_STACK (cube->lits);
+	  PUSH_STACK (cube->lits, -split);
+	  struct cube *child = new_cube (pool, cube->id, cube->limit,
+					 size + 1, BEGIN_STACK (cube->lits));
+	  push_cube (pool, worker, child);
+	  TOP_STACK (cube->lits) = split;
+	  child = new_cube (pool, cube->id, cube->limit,
+			    size + 1, BEGIN_STACK (cube->lits));
+	  push_cube (pool, worker, child);
+	}
+      else
+	{
+	  cube->limit *= 2;
+	  push_cube (pool, worker, cube);
+	  cube = 0;
+	}
+    }
+  if (cube)
+    delete_cube (pool, cube);
+  wakeup_workers (pool);
+  unlock_pool (pool);
+}
+
+static void
+solve_cube (pool * pool, worker * worker, cube * cube)
+{
+  kissat *solver = worker->solver;
+  for (all_stack (int, elit, cube->lits))
+    kissat_assume (solver, elit);
+  const uint64_t limit = MIN (cube->limit, UINT_MAX);
+  kissat_set_conflict_limit (solver, (unsigned) limit);
+  const uint64_t conflicts = solver->statistics.conflicts;
+  const double start = kissat_wall_clock_time ();
+  int res = kissat_solve (solver);
+  const bool terminated =
+    !res && (pool->done || pool->solver->termination.flagged);
+  int split = 0;
+  if (!res && !terminated)
+    res = kissat_lookahead (solver, SIZE_STACK (cube->lits),
+			    BEGIN_STACK (cube->lits), &split);
+  conquered conquered;
+  conquered.id = cube->id;
+  conquered.parent = cube->parent;
+  conquered.size = SIZE_STACK (cube->lits);
+  conquered.thread = worker->id;
+  conquered.res = res;
+  conquered.split = split;
+  conquered.terminated = terminated;
+  conquered.conflicts = solver->statistics.conflicts - conflicts;
+  conquered.time = kissat_wall_clock_time () - start;
+  finish_cube (pool, worker, cube, &conquered);
+}
+
+static void *
+conquer (void *ptr)
+{
+  worker *worker = ptr;
+  pool *pool = worker->pool;
+  if (worker->id)
+    kissat_load_portfolio_formula (worker->solver,
+				   &pool->solver->portfolio);
+  cube *cube;
+  while ((cube = next_cube (pool, worker)))
+    solve_cube (pool, worker, cube);
+  return 0;
+}
+
+static void
+conquer_cubes (pool * pool)
+{
+  const unsigned threads = pool->threads;
+#ifdef _POSIX_C_SOURCE
+  for (unsigned id = 1; id < threads; id++)
+    {
+      worker *worker = pool->workers + id;
+      worker->started = !pthread_create (&worker->thread, 0,
+					 conquer, worker);
+    }
+  conquer (pool->workers);
+  for (unsigned id = 1; id < threads; id++)
+    {
+      worker *worker = pool->workers + id;
+      if (worker->started)
+	pthread_join (worker->thread, 0);
+    }
+#else
+  (void) threads;
+  conquer (pool->workers);
+#endif
+}
+
+int
+kissat_cube_and_conquer (kissat * solver)
+{
+  portfolio *portfolio = &solver->portfolio;
+  const unsigned threads = portfolio->threads;
+  const unsigned depth = GET_OPTION (cubes);
+  kissat_verbose (solver, "cube-and-conquer on %zu clauses "
+		  "with depth %u and %u threads",
+		  portfolio->clauses, depth, threads);
+  CLEAR_STACK (portfolio->cubes);
+  pool pool;
+  pool.solver = solver;
+  pool.threads = threads;
+  pool.busy = pool.generated = pool.refuted = 0;
+  pool.winner = 0;
+  pool.res = 0;
+  pool.done = false;
+  pool.workers = kissat_calloc (solver, threads, sizeof *pool.workers);
+  kissat **solvers = kissat_calloc (solver, threads, sizeof *solvers);
+  for (unsigned id = 0; id < threads; id++)
+    {
+      worker *worker = pool.workers + id;
+      kissat *conqueror = kissat_new_portfolio_worker (solver, id, threads);
+      kissat_set_option (conqueror, "incremental", 1);
+#ifndef QUIET
+      kissat_set_option (conqueror, "quiet", 1);
+#endif
+      worker->solver = solvers[id] = conqueror;
+      worker->pool = &pool;
+      worker->id = id;
+    }
+  exchange *exchange = 0;
+  if (GET_OPTION (share))
+    {
+      exchange = kissat_new_exchange (solver);
+      for (unsigned id = 0; id < threads; id++)
+	kissat_connect_sharing (solvers[id], exchange, id);
+    }
+  kissat_set_portfolio_workers (solver, solvers);
+  kissat *lookahead = solvers[0];
+  kissat_load_portfolio_formula (lookahead, portfolio);
+  kissat_set_conflict_limit (lookahead, GET_OPTION (cubeconflicts));
+  int res = kissat_solve (lookahead);
+  if (!res && !solver->termination.flagged)
+    {
+      ints prefix;
+      INIT_STACK (prefix);
+      generate_cubes (&pool, lookahead, &prefix, depth);
+      RELEASE_STACK (prefix);
+      kissat_verbose (solver, "generated %u cubes "
+		      "(%u more refuted by lookahead)",
+		      pool.generated, pool.refuted);
+#ifdef _POSIX_C_SOURCE
+      pthread_mutex_init (&pool.lock, 0);
+      pthread_cond_init (&pool.wakeup, 0);
+#endif
+      conquer_cubes (&pool);
+#ifdef _POSIX_C_SOURCE
+      pthread_cond_destroy (&pool.wakeup);
+      pthread_mutex_destroy (&pool.lock);
+#endif
+      res = pool.res;
+    }
+  kissat_set_portfolio_workers (solver, 0);
+  if (exchange)
+    {
+      for (unsigned id = 0; id < threads; id++)
+	kissat_release_sharing (solvers[id]);
+      kissat_delete_exchange (solver, exchange);
+    }
+  for (unsigned id = 0; id < threads; id++)
+    {
+      worker *worker = pool.workers + id;
+      for (size_t i = worker->bottom; i < SIZE_STACK (worker->cubes); i++)
+	delete_cube (&pool, PEEK_STACK (worker->cubes, i));
+      RELEASE_STACK (worker->cubes);
+    }
+  const unsigned winner = pool.winner;
+  for (unsigned id = 0; id < threads; id++)
+    if (id != winner)
+      kissat_release (solvers[id]);
+  portfolio->winner = solvers[winner];
+#if !defined(QUIET) && !defined(NOPTIONS)
+  kissat_set_option (portfolio->winner, "quiet", GET_OPTION (quiet));
+#endif
+  kissat_dealloc (solver, solvers, threads, sizeof *solvers);
+  kissat_dealloc (solver, pool.workers, threads, sizeof *pool.workers);
+  if (res)
+    kissat_verbose (solver, "conquered %zu cubes with result %d",
+		    SIZE_STACK (portfolio->cubes), res);
+  else
+    kissat_verbose (solver, "cube-and-conquer did not succeed");
+  solver->termination.flagged = 0;
+  return res;
+}
+
+#ifndef QUIET
+
+void
+kissat_print_cubes (kissat * solver)
+{
+  const conquereds *cubes = &solver->portfolio.cubes;
+  if (EMPTY_STACK (*cubes))
+    return;
+  kissat_section (solver, "cubes");
+  size_t satisfied = 0, refuted = 0, split = 0, retried = 0;
+  size_t terminated = 0;
+  kissat_message (solver, "%6s %6s %4s %6s %-10s %10s %8s",
+		  "cube", "parent", "size", "thread", "status",
+		  "conflicts", "seconds");
+  for (all_stack (conquered, conquered, *cubes))
+    {
+      const char *status;
+      if (conquered.res == 10)
+	status = "satisfied", satisfied++;
+      else if (conquered.res == 20)
+	status = "refuted", refuted++;
+      else if (conquered.terminated)
+	status = "terminated", terminated++;
+      else if (conquered.split)
+	status = "split", split++;
+      else
+	status = "retried", retried++;
+      char parent[16];
+      if (conquered.parent == UINT_MAX)
+	sprintf (parent, "-");
+      else
+	sprintf (parent, "%u", conquered.parent);
+      kissat_message (solver, "%6u %6s %4u %6u %-10s %10" PRIu64 " %8.2f",
+		      conquered.id, parent, conquered.size, conquered.thread,
+		      status, conquered.conflicts, conquered.time);
+    }
+  kissat_line (solver);
+  kissat_message (solver, "solved %zu cubes: %zu satisfied, %zu refuted, "
+		  "%zu split, %zu retried, %zu terminated",
+		  SIZE_STACK (*cubes), satisfied, refuted, split, retried,
+		  terminated);
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef _cube_h_INCLUDED
+#define _cube_h_INCLUDED
+
+#include "stack.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct conquered conquered;
+
+// Summary of solving one cube during cube-and-conquer, where 'res' is
+// '10' (satisfiable), '20' (refuted) or zero if solving was terminated or
+// the cube was split or otherwise (with 'split' zero) given back to the
+// pool with a larger conflict limit.
+
+struct conquered
+{
+  unsigned id;
+  unsigned parent;
+  unsigned size;
+  unsigned thread;
+  int res;
+  int split;
+  bool terminated;
+  uint64_t conflicts;
+  double time;
+};
+
+// *INDENT-OFF*
+typedef STACK (conquered) conquereds;
+// *INDENT-ON*
+
+struct kissat;
+
+bool kissat_cubing (struct kissat *);
+int kissat_cube_and_conquer (struct kissat *);
+
+#ifndef QUIET
+void kissat_print_cubes (struct kissat *);
+#endif
+
+#endif
@@ -6,19 +6,25 @@
 static inline void
 mark_clause_as_used (kissat * solver, clause * c)
 {
+  if (c->shared)
+    {
+      c->shared = false;
+      INC (shared_useful);
+    }
   if (!c->redundant)
     return;
   if (c->keep)
     return;
-  const unsigned used = c->used;
+  cold *const cold = COLD (c);
+  const unsigned used = cold->used;
   LOGCLS (c, "using");
-  c->used = 1;
-  const unsigned old_glue = c->glue;
+  cold->used = 1;
+  const unsigned old_glue = cold->glue;
   const unsigned new_glue = kissat_recompute_glue (solver, c, old_glue);
   if (new_glue < old_glue)
     kissat_promote_clause (solver, c, new_glue);
-  else if (used && c->glue <= (unsigned) GET_OPTION (tier2))
-    c->used = 2;
+  else if (used && cold->glue <= (unsigned) GET_OPTION (tier2))
+    cold->used = 2;
 }
 
 static inline bool
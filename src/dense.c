@@ -78,7 +78,7 @@ flush_large_watches (kissat * solver,
 	  else
 	    {
 	      flushed++;
-	      p++;
+	      p += kissat_watch_words (watch) - 1;
 	    }
 
 	}
@@ -257,11 +257,7 @@ resume_watching_large_clauses_after_elimination (kissat * solver)
       c->searched = 2;
 
       const reference ref = (ward *) c - arena;
-      const unsigned l0 = lits[0];
-      const unsigned l1 = lits[1];
-
-      kissat_push_blocking_watch (solver, watches + l0, l1, ref);
-      kissat_push_blocking_watch (solver, watches + l1, l0, ref);
+      kissat_push_clause_watches (solver, watches, c, ref);
 
 #ifdef LOGGING
       if (c->redundant)
@@ -31,7 +31,7 @@ static void
 dump_clause (kissat * solver, clause * c)
 {
   if (c->redundant)
-    printf ("redundant glue %u", c->glue);
+    printf ("redundant glue %u", COLD (c)->glue);
   else
     printf ("irredundant");
   const reference ref = kissat_reference_clause (solver, c);
@@ -304,6 +304,8 @@ can_eliminate_variable (kissat * solver, unsigned idx)
     return false;
   if (!flags->eliminate)
     return false;
+  if (FROZEN (idx))
+    return false;
 
   return true;
 }
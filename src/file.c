@@ -8,6 +8,22 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#ifdef _POSIX_C_SOURCE
+#include <sys/mman.h>
+#endif
+
+#ifdef ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef LZMA
+#include <lzma.h>
+#endif
+
+#ifdef BZIP2
+#include <bzlib.h>
+#endif
+
 bool
 kissat_file_exists (const char *path)
 {
@@ -207,6 +223,353 @@ write_pipe (const char *fmt, const char *path)
   return open_pipe (fmt, path, "w");
 }
 
+static void
+map_file (file * file)
+{
+  struct stat buf;
+  const int fd = fileno (file->file);
+  if (fd < 0 || fstat (fd, &buf) || !S_ISREG (buf.st_mode))
+    return;
+  const size_t size = buf.st_size;
+  if (!size || (off_t) size != buf.st_size)
+    return;
+  void *map = mmap (0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (map == MAP_FAILED)
+    return;
+#ifdef MADV_SEQUENTIAL
+  (void) madvise (map, size, MADV_SEQUENTIAL);
+#endif
+  file->map = map;
+  file->pos = file->map;
+  file->end = file->map + size;
+}
+
+#endif
+
+#ifdef BUILTIN_DECOMPRESSION
+
+// Decompression with linked libraries avoids spawning external tools and
+// copying all input through a pipe.  The compressed file is read in large
+// blocks and inflated into the same 'pos' and 'end' buffer used for mapped
+// files, which allows the parser to scan decompressed input directly.
+// At the end of the input the decoders are called until they neither
+// consume nor produce anything.  If this happens in the middle of a stream
+// or the decoder fails, decompression stops with an error message, which
+// the parser reports instead of treating the stream as complete.
+
+#define DECOMPRESSION_BUFFER_SIZE (1u << 20)
+
+enum format
+{
+  GZIP_FORMAT = 1,
+  XZ_FORMAT = 2,
+  BZIP2_FORMAT = 3,
+};
+
+struct decompressor
+{
+  enum format format;
+  bool drained;
+  bool finished;
+  bool incomplete;
+  const char *error;
+  size_t available;
+  unsigned char *next;
+#ifdef ZLIB
+  z_stream gzip;
+#endif
+#ifdef LZMA
+  lzma_stream xz;
+#endif
+#ifdef BZIP2
+  bz_stream bzip2;
+#endif
+  unsigned char input[DECOMPRESSION_BUFFER_SIZE];
+  unsigned char output[DECOMPRESSION_BUFFER_SIZE];
+};
+
+static void
+decompression_error (decompressor * decompressor, const char *error)
+{
+  decompressor->finished = true;
+  decompressor->error = error;
+}
+
+#if defined(ZLIB) || defined(BZIP2)
+
+static void
+decompression_stalled (decompressor * decompressor, size_t consumed,
+		       size_t produced, const char *truncated)
+{
+  if (consumed || produced)
+    decompressor->incomplete = true;
+  else if (decompressor->drained)
+    {
+      decompressor->finished = true;
+      if (decompressor->incomplete)
+	decompressor->error = truncated;
+    }
+}
+
+#endif
+
+#ifdef ZLIB
+
+static size_t
+decompress_gzip (decompressor * decompressor)
+{
+  z_stream *stream = &decompressor->gzip;
+  stream->next_in = decompressor->next;
+  stream->avail_in = decompressor->available;
+  stream->next_out = decompressor->output;
+  stream->avail_out = sizeof decompressor->output;
+  const int res = inflate (stream, Z_NO_FLUSH);
+  const size_t consumed = decompressor->available - stream->avail_in;
+  const size_t produced = sizeof decompressor->output - stream->avail_out;
+  decompressor->next = stream->next_in;
+  decompressor->available = stream->avail_in;
+  if (res == Z_STREAM_END)
+    {
+      inflateReset (stream);
+      decompressor->incomplete = false;
+    }
+  else if (res == Z_OK || res == Z_BUF_ERROR)
+    decompression_stalled (decompressor, consumed, produced,
+			   "truncated gzip stream");
+  else
+    decompression_error (decompressor, "corrupted gzip stream");
+  return produced;
+}
+
+#endif
+
+#ifdef LZMA
+
+static size_t
+decompress_xz (decompressor * decompressor)
+{
+  lzma_stream *stream = &decompressor->xz;
+  stream->next_in = decompressor->next;
+  stream->avail_in = decompressor->available;
+  stream->next_out = decompressor->output;
+  stream->avail_out = sizeof decompressor->output;
+  const lzma_action action = decompressor->drained ? LZMA_FINISH : LZMA_RUN;
+  const lzma_ret res = lzma_code (stream, action);
+  decompressor->next = (unsigned char *) stream->next_in;
+  decompressor->available = stream->avail_in;
+  if (res == LZMA_STREAM_END)
+    decompressor->finished = true;
+  else if (res == LZMA_BUF_ERROR)
+    decompression_error (decompressor, "truncated xz stream");
+  else if (res != LZMA_OK)
+    decompression_error (decompressor, "corrupted xz stream");
+  return sizeof decompressor->output - stream->avail_out;
+}
+
+#endif
+
+#ifdef BZIP2
+
+static size_t
+decompress_bzip2 (decompressor * decompressor)
+{
+  bz_stream *stream = &decompressor->bzip2;
+  stream->next_in = (char *) decompressor->next;
+  stream->avail_in = decompressor->available;
+  stream->next_out = (char *) decompressor->output;
+  stream->avail_out = sizeof decompressor->output;
+  const int res = BZ2_bzDecompress (stream);
+  const size_t consumed = decompressor->available - stream->avail_in;
+  const size_t produced = sizeof decompressor->output - stream->avail_out;
+  decompressor->next = (unsigned char *) stream->next_in;
+  decompressor->available = stream->avail_in;
+  if (res == BZ_STREAM_END)
+    {
+      decompressor->incomplete = false;
+      BZ2_bzDecompressEnd (stream);
+      if (BZ2_bzDecompressInit (stream, 0, 0) != BZ_OK)
+	{
+	  memset (stream, 0, sizeof *stream);
+	  decompression_error (decompressor,
+			       "failed to restart bzip2 decompression");
+	}
+    }
+  else if (res == BZ_OK)
+    decompression_stalled (decompressor, consumed, produced,
+			   "truncated bzip2 stream");
+  else
+    decompression_error (decompressor, "corrupted bzip2 stream");
+  return produced;
+}
+
+#endif
+
+int
+kissat_decompress_and_getc (file * file)
+{
+  decompressor *decompressor = file->decompressor;
+  assert (decompressor);
+  assert (file->pos == file->end);
+  while (!decompressor->finished)
+    {
+      if (!decompressor->available && !decompressor->drained)
+	{
+	  decompressor->next = decompressor->input;
+	  decompressor->available =
+	    fread (decompressor->input, 1, sizeof decompressor->input,
+		   file->file);
+	  if (!decompressor->available)
+	    {
+	      decompressor->drained = true;
+	      if (ferror (file->file))
+		{
+		  decompression_error (decompressor, "read error");
+		  break;
+		}
+	    }
+	}
+      size_t produced = 0;
+      switch (decompressor->format)
+	{
+#ifdef ZLIB
+	case GZIP_FORMAT:
+	  produced = decompress_gzip (decompressor);
+	  break;
+#endif
+#ifdef LZMA
+	case XZ_FORMAT:
+	  produced = decompress_xz (decompressor);
+	  break;
+#endif
+#ifdef BZIP2
+	case BZIP2_FORMAT:
+	  produced = decompress_bzip2 (decompressor);
+	  break;
+#endif
+	default:
+	  assert (!"unexpected decompression format");
+	  decompressor->finished = true;
+	  break;
+	}
+      if (produced)
+	{
+	  file->pos = decompressor->output;
+	  file->end = decompressor->output + produced;
+	  file->bytes++;
+	  return *file->pos++;
+	}
+    }
+  return EOF;
+}
+
+const char *
+kissat_decompression_error (file * file)
+{
+  return file->decompressor ? file->decompressor->error : 0;
+}
+
+static bool
+init_decompressor (decompressor * decompressor, enum format format)
+{
+  decompressor->format = format;
+  switch (format)
+    {
+#ifdef ZLIB
+    case GZIP_FORMAT:
+      return inflateInit2 (&decompressor->gzip, 15 + 32) == Z_OK;
+#endif
+#ifdef LZMA
+    case XZ_FORMAT:
+      return lzma_auto_decoder (&decompressor->xz, UINT64_MAX,
+				LZMA_CONCATENATED) == LZMA_OK;
+#endif
+#ifdef BZIP2
+    case BZIP2_FORMAT:
+      return BZ2_bzDecompressInit (&decompressor->bzip2, 0, 0) == BZ_OK;
+#endif
+    default:
+      return false;
+    }
+}
+
+static void
+release_decompressor (decompressor * decompressor)
+{
+  switch (decompressor->format)
+    {
+#ifdef ZLIB
+    case GZIP_FORMAT:
+      inflateEnd (&decompressor->gzip);
+      break;
+#endif
+#ifdef LZMA
+    case XZ_FORMAT:
+      lzma_end (&decompressor->xz);
+      break;
+#endif
+#ifdef BZIP2
+    case BZIP2_FORMAT:
+      BZ2_bzDecompressEnd (&decompressor->bzip2);
+      break;
+#endif
+    default:
+      break;
+    }
+  free (decompressor);
+}
+
+static bool
+open_decompressed (file * file, const char *path,
+		   enum format format, const int *sig)
+{
+  if (!kissat_file_readable (path))
+    return false;
+  if (!match_signature (path, sig))
+    return false;
+  decompressor *decompressor = calloc (1, sizeof *decompressor);
+  if (!decompressor)
+    return false;
+  if (!init_decompressor (decompressor, format))
+    {
+      free (decompressor);
+      return false;
+    }
+  FILE *f = fopen (path, "r");
+  if (!f)
+    {
+      release_decompressor (decompressor);
+      return false;
+    }
+  file->file = f;
+  file->close = true;
+  file->reading = true;
+  file->compressed = true;
+  file->path = path;
+  file->bytes = 0;
+  file->map = file->pos = file->end = 0;
+  file->decompressor = decompressor;
+  return true;
+}
+
+bool
+kissat_decompressed_internally (const char *path)
+{
+#ifdef ZLIB
+  if (kissat_has_suffix (path, ".gz"))
+    return true;
+#endif
+#ifdef LZMA
+  if (kissat_has_suffix (path, ".lzma") || kissat_has_suffix (path, ".xz"))
+    return true;
+#endif
+#ifdef BZIP2
+  if (kissat_has_suffix (path, ".bz2"))
+    return true;
+#endif
+  (void) path;
+  return false;
+}
+
 #endif
 
 void
@@ -218,6 +581,8 @@ kissat_read_already_open_file (file * file, FILE * f, const char *path)
   file->compressed = false;
   file->path = path;
   file->bytes = 0;
+  file->map = file->pos = file->end = 0;
+  file->decompressor = 0;
 }
 
 void
@@ -229,6 +594,8 @@ kissat_write_already_open_file (file * file, FILE * f, const char *path)
   file->compressed = false;
   file->path = path;
   file->bytes = 0;
+  file->map = file->pos = file->end = 0;
+  file->decompressor = 0;
 }
 
 #ifndef _POSIX_C_SOURCE
@@ -236,6 +603,10 @@ kissat_write_already_open_file (file * file, FILE * f, const char *path)
 bool
 kissat_looks_like_a_compressed_file (const char *path)
 {
+#ifdef BUILTIN_DECOMPRESSION
+  if (kissat_decompressed_internally (path))
+    return false;
+#endif
 #define RETURN_TRUE_IF_COMPRESSED(SUFFIX,SIGNATURE) \
   if (kissat_has_suffix (path, SUFFIX) && \
       match_signature (path, SIGNATURE)) \
@@ -255,6 +626,24 @@ kissat_looks_like_a_compressed_file (const char *path)
 bool
 kissat_open_to_read_file (file * file, const char *path)
 {
+#ifdef BUILTIN_DECOMPRESSION
+#define READ_DECOMPRESSED(SUFFIX, FORMAT, SIG) \
+do { \
+  if (kissat_has_suffix (path, SUFFIX) && \
+      open_decompressed (file, path, FORMAT, SIG)) \
+    return true; \
+} while (0)
+#ifdef BZIP2
+  READ_DECOMPRESSED (".bz2", BZIP2_FORMAT, bz2sig);
+#endif
+#ifdef ZLIB
+  READ_DECOMPRESSED (".gz", GZIP_FORMAT, gzsig);
+#endif
+#ifdef LZMA
+  READ_DECOMPRESSED (".lzma", XZ_FORMAT, lzmasig);
+  READ_DECOMPRESSED (".xz", XZ_FORMAT, xzsig);
+#endif
+#endif
 #ifdef _POSIX_C_SOURCE
 #define READ_PIPE(SUFFIX, CMD, SIG) \
 do { \
@@ -268,6 +657,8 @@ do { \
       file->compressed = true; \
       file->path = path; \
       file->bytes = 0; \
+      file->map = file->pos = file->end = 0; \
+      file->decompressor = 0; \
       return true; \
     } \
 } while (0)
@@ -285,7 +676,11 @@ do { \
   file->compressed = false;
   file->path = path;
   file->bytes = 0;
-
+  file->map = file->pos = file->end = 0;
+  file->decompressor = 0;
+#ifdef _POSIX_C_SOURCE
+  map_file (file);
+#endif
   return true;
 }
 
@@ -307,6 +702,8 @@ do { \
       file->compressed = true; \
       file->path = path; \
       file->bytes = 0; \
+      file->map = file->pos = file->end = 0; \
+      file->decompressor = 0; \
       return true; \
     } \
 } while (0)
@@ -324,6 +721,8 @@ do { \
   file->compressed = false;
   file->path = path;
   file->bytes = 0;
+  file->map = file->pos = file->end = 0;
+  file->decompressor = 0;
   return true;
 }
 
@@ -332,6 +731,25 @@ kissat_close_file (file * file)
 {
   assert (file);
   assert (file->file);
+#ifdef _POSIX_C_SOURCE
+  if (file->map)
+    {
+      munmap ((void *) file->map, file->end - file->map);
+      file->map = file->pos = file->end = 0;
+    }
+#endif
+#ifdef BUILTIN_DECOMPRESSION
+  if (file->decompressor)
+    {
+      release_decompressor (file->decompressor);
+      file->decompressor = 0;
+      file->pos = file->end = 0;
+      assert (file->close);
+      fclose (file->file);
+      file->file = 0;
+      return;
+    }
+#endif
 #ifdef _POSIX_C_SOURCE
   if (file->close && file->compressed)
     pclose (file->file);
@@ -12,7 +12,12 @@ bool kissat_file_writable (const char *path);
 size_t kissat_file_size (const char *path);
 bool kissat_find_executable (const char *name);
 
+#if defined(ZLIB) || defined(LZMA) || defined(BZIP2)
+#define BUILTIN_DECOMPRESSION
+#endif
+
 typedef struct file file;
+typedef struct decompressor decompressor;
 
 struct file
 {
@@ -22,6 +27,10 @@ struct file
   bool compressed;
   const char *path;
   uint64_t bytes;
+  const unsigned char *map;
+  const unsigned char *pos;
+  const unsigned char *end;
+  decompressor *decompressor;
 };
 
 void kissat_read_already_open_file (file *, FILE *, const char *path);
@@ -32,6 +41,14 @@ bool kissat_open_to_write_file (file *, const char *path);
 
 void kissat_close_file (file *);
 
+#ifdef BUILTIN_DECOMPRESSION
+
+bool kissat_decompressed_internally (const char *path);
+int kissat_decompress_and_getc (file *);
+const char *kissat_decompression_error (file *);
+
+#endif
+
 #ifndef _POSIX_C_SOURCE
 
 bool kissat_looks_like_a_compressed_file (const char *path);
@@ -44,6 +61,17 @@ kissat_getc (file * file)
   assert (file);
   assert (file->file);
   assert (file->reading);
+  if (file->pos != file->end)
+    {
+      file->bytes++;
+      return *file->pos++;
+    }
+  if (file->map)
+    return EOF;
+#ifdef BUILTIN_DECOMPRESSION
+  if (file->decompressor)
+    return kissat_decompress_and_getc (file);
+#endif
 #ifdef _POSIX_C_SOURCE
   int res = getc_unlocked (file->file);
 #else
@@ -23,6 +23,9 @@ struct flags
 #define ACTIVE(IDX) (FLAGS(IDX)->active)
 #define ELIMINATED(IDX) (FLAGS(IDX)->eliminated)
 
+#define FROZEN(IDX) \
+  (assert ((IDX) < VARS), solver->frozen[IDX])
+
 struct kissat;
 
 void kissat_activate_literal (struct kissat *, unsigned);
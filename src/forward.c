@@ -143,7 +143,7 @@ find_forward_subsumption_candidates (kissat * solver, references * candidates)
 	break;
       if (c->garbage)
 	continue;
-      c->subsume = false;
+      COLD (c)->subsume = false;
       if (c->redundant)
 	continue;
       if (c->size > clslim)
@@ -467,14 +467,14 @@ forward_subsumed_clause (kissat * solver, clause * c,
 		}
 	      assert (new_size == non_false - 1);
 	      assert (new_size > 2);
-	      if (!c->shrunken)
+	      if (!COLD (c)->shrunken)
 		{
-		  c->shrunken = true;
+		  COLD (c)->shrunken = true;
 		  lits[c->size - 1] = INVALID_LIT;
 		}
 	      c->size = new_size;
 	      c->searched = 2;
-	      c->subsume = true;
+	      COLD (c)->subsume = true;
 	      LOGCLS (c, "forward strengthened");
 	    }
 	  else
@@ -482,7 +482,7 @@ forward_subsumed_clause (kissat * solver, clause * c,
 	      assert (non_false == 3);
 	      LOGCLS (c, "garbage");
 	      assert (!c->garbage);
-	      const size_t bytes = kissat_actual_bytes_of_clause (c);
+	      const size_t bytes = kissat_actual_bytes_of_clause (solver, c);
 	      ADD (arena_garbage, bytes);
 	      c->garbage = true;
 	      unsigned first = INVALID_LIT, second = INVALID_LIT;
@@ -652,7 +652,7 @@ forward_subsume_all_clauses (kissat * solver)
       assert (kissat_clause_in_arena (solver, c));
       if (c->garbage)
 	continue;
-      if (q < p && !c->subsume)
+      if (q < p && !COLD (c)->subsume)
 	continue;
 #ifndef QUIET
       remain++;
@@ -3,6 +3,22 @@
 #include "ifthenelse.h"
 #include "inline.h"
 
+// The ternary clauses of the candidate literal are dereferenced only once
+// and their other two literals copied to a local stack, so that matching
+// all pairs of them does not have to access the arena again.
+
+typedef struct ternary ternary;
+
+struct ternary
+{
+  watch watch;
+  unsigned lits[2];
+};
+
+// *INDENT-OFF*
+typedef STACK (ternary) ternaries;
+// *INDENT-ON*
+
 static bool
 get_ternary_clause (kissat * solver, reference ref,
 		    unsigned *p, unsigned *q, unsigned *r)
@@ -125,34 +141,40 @@ kissat_find_if_then_else_gate (kissat * solver,
   const uint64_t limit = GET_OPTION (eliminateocclim);
   if (large_clauses * large_clauses > limit)
     return false;
-  const watch *const last = end - 1;
-  uint64_t steps = 0;
-  for (const watch * p1 = begin; steps < limit && p1 != last; p1++)
+  ternaries ternaries;
+  INIT_STACK (ternaries);
+  for (const watch * p = begin; p != end; p++)
     {
-      watch w1 = *p1;
-      if (w1.type.binary)
+      const watch watch = *p;
+      if (watch.type.binary)
 	continue;
-      unsigned a1, b1, c1;
-      if (!get_ternary_clause (solver, p1->large.ref, &a1, &b1, &c1))
+      unsigned a, b, c;
+      if (!get_ternary_clause (solver, watch.large.ref, &a, &b, &c))
 	continue;
-      if (b1 == lit)
-	SWAP (unsigned, a1, b1);
-      if (c1 == lit)
-	SWAP (unsigned, a1, c1);
-      assert (a1 == lit);
-      for (const watch * p2 = p1 + 1; steps < limit && p2 != end; p2++)
+      if (b == lit)
+	SWAP (unsigned, a, b);
+      if (c == lit)
+	SWAP (unsigned, a, c);
+      assert (a == lit);
+      const ternary ternary = {.watch = watch,.lits = {b, c} };
+      PUSH_STACK (ternaries, ternary);
+    }
+  const ternary *const begin_ternaries = BEGIN_STACK (ternaries);
+  const ternary *const end_ternaries = END_STACK (ternaries);
+  bool res = false;
+  uint64_t steps = 0;
+  for (const ternary * t1 = begin_ternaries;
+       !res && steps < limit && t1 != end_ternaries; t1++)
+    {
+      watch w1 = t1->watch;
+      const unsigned b1 = t1->lits[0];
+      const unsigned c1 = t1->lits[1];
+      for (const ternary * t2 = t1 + 1;
+	   steps < limit && t2 != end_ternaries; t2++)
 	{
-	  watch w2 = *p2;
-	  if (w2.type.binary)
-	    continue;
-	  unsigned a2, b2, c2;
-	  if (!get_ternary_clause (solver, p2->large.ref, &a2, &b2, &c2))
-	    continue;
-	  if (b2 == lit)
-	    SWAP (unsigned, a2, b2);
-	  if (c2 == lit)
-	    SWAP (unsigned, a2, c2);
-	  assert (a2 == lit);
+	  watch w2 = t2->watch;
+	  unsigned b2 = t2->lits[0];
+	  unsigned c2 = t2->lits[1];
 	  if (STRIP (b1) == STRIP (c2))
 	    SWAP (unsigned, b2, c2);
 	  if (STRIP (c1) == STRIP (c2))
@@ -187,8 +209,10 @@ kissat_find_if_then_else_gate (kissat * solver,
 	  PUSH_STACK (solver->gates[!negative], w3);
 	  PUSH_STACK (solver->gates[!negative], w4);
 	  INC (if_then_else_extracted);
-	  return true;
+	  res = true;
+	  break;
 	}
     }
-  return false;
+  RELEASE_STACK (ternaries);
+  return res;
 }
@@ -85,6 +85,8 @@ kissat_push_binary_watch (kissat * solver, watches * watches,
 {
   const watch watch = kissat_binary_watch (other, redundant);
   PUSH_WATCHES (*watches, watch);
+  if (solver->watching)
+    kissat_move_binary_watch_before_large_watches (solver, watches);
 }
 
 static inline void
@@ -98,6 +100,48 @@ kissat_push_blocking_watch (kissat * solver, watches * watches,
   PUSH_WATCHES (*watches, tail);
 }
 
+static inline void
+kissat_push_ternary_watch (kissat * solver, watches * watches,
+			   unsigned first, unsigned second, reference ref)
+{
+  assert (solver->watching);
+  const watch head = kissat_ternary_watch (first);
+  PUSH_WATCHES (*watches, head);
+  const watch tail = kissat_large_watch (ref);
+  PUSH_WATCHES (*watches, tail);
+  const watch third = kissat_ternary_watch (second);
+  PUSH_WATCHES (*watches, third);
+}
+
+static inline bool
+kissat_watching_ternary (kissat * solver, unsigned size)
+{
+#ifdef NOPTIONS
+  (void) solver;
+#endif
+  return size == 3 && GET_OPTION (ternary);
+}
+
+static inline void
+kissat_push_clause_watches (kissat * solver, watches * all_watches,
+			    const clause * c, reference ref)
+{
+  const unsigned *const lits = c->lits;
+  const unsigned l0 = lits[0];
+  const unsigned l1 = lits[1];
+  if (kissat_watching_ternary (solver, c->size))
+    {
+      const unsigned l2 = lits[2];
+      kissat_push_ternary_watch (solver, all_watches + l0, l1, l2, ref);
+      kissat_push_ternary_watch (solver, all_watches + l1, l0, l2, ref);
+    }
+  else
+    {
+      kissat_push_blocking_watch (solver, all_watches + l0, l1, ref);
+      kissat_push_blocking_watch (solver, all_watches + l1, l0, ref);
+    }
+}
+
 static inline void
 kissat_watch_other (kissat * solver,
 		    bool redundant, unsigned lit, unsigned other)
@@ -164,6 +208,17 @@ kissat_watch_reference (kissat * solver,
   kissat_watch_blocking (solver, b, a, ref);
 }
 
+static inline void
+kissat_watch_ternary (kissat * solver, unsigned lit,
+		      unsigned first, unsigned second, reference ref)
+{
+  assert (solver->watching);
+  LOGREF (ref, "watching %s ternary %s %s in",
+	  LOGLIT (lit), LOGLIT (first), LOGLIT (second));
+  watches *watches = &WATCHES (lit);
+  kissat_push_ternary_watch (solver, watches, first, second, ref);
+}
+
 static inline void
 kissat_connect_literal (kissat * solver, unsigned lit, reference ref)
 {
@@ -216,7 +271,14 @@ kissat_watch_clause (kissat * solver, clause * c)
 {
   assert (c->searched < c->size);
   const reference ref = kissat_reference_clause (solver, c);
-  kissat_watch_reference (solver, c->lits[0], c->lits[1], ref);
+  const unsigned *const lits = c->lits;
+  if (kissat_watching_ternary (solver, c->size))
+    {
+      kissat_watch_ternary (solver, lits[0], lits[1], lits[2], ref);
+      kissat_watch_ternary (solver, lits[1], lits[0], lits[2], ref);
+    }
+  else
+    kissat_watch_reference (solver, lits[0], lits[1], ref);
 }
 
 static inline int
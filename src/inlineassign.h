@@ -39,11 +39,6 @@ kissat_assign (kissat * solver, const bool probing, const unsigned level,
       kissat_mark_fixed_literal (solver, lit);
       assert (solver->unflushed < UINT_MAX);
       solver->unflushed++;
-      if (reason != UNIT_REASON)
-	{
-	  CHECK_AND_ADD_UNIT (lit);
-	  ADD_UNIT_TO_PROOF (lit);
-	}
     }
 
   const size_t trail = SIZE_ARRAY (solver->trail);
@@ -78,6 +73,12 @@ kissat_assign (kissat * solver, const bool probing, const unsigned level,
 #endif
   struct assigned *a = assigned + idx;
   *a = b;
+
+  if (!level && reason != UNIT_REASON)
+    {
+      CHECK_AND_ADD_UNIT (lit);
+      ADD_UNIT_TO_PROOF (lit);
+    }
 }
 
 static inline unsigned
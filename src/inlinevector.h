@@ -158,7 +158,7 @@ kissat_push_vectors (kissat * solver, vector * vector, unsigned e)
     )
     {
       if (EMPTY_STACK (*stack))
-	PUSH_STACK (*stack, 0);
+	ACCOUNT (vectors, PUSH_STACK (*stack, 0));
       if (FULL_STACK (*stack))
 	{
 	  unsigned *end = kissat_enlarge_vector (solver, vector);
@@ -1,4 +1,5 @@
 #include "allocate.h"
+#include "assume.h"
 #include "backtrack.h"
 #include "error.h"
 #include "search.h"
@@ -10,12 +11,14 @@
 #include "require.h"
 #include "resize.h"
 #include "resources.h"
+#include "restore.h"
 
 #include <assert.h>
 #include <inttypes.h>
 #include <limits.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 kissat *
 kissat_init (void)
@@ -31,9 +34,11 @@ kissat_init (void)
 #endif
   START (total);
   kissat_init_queue (solver);
+  kissat_init_portfolio (solver);
   assert (INTERNAL_MAX_LIT < UINT_MAX);
   kissat_push_frame (solver, UINT_MAX);
   solver->watching = true;
+  solver->simd = kissat_simd_supported ();
   solver->conflict.size = 2;
   solver->conflict.keep = true;
   solver->scinc = 1.0;
@@ -70,32 +75,50 @@ do { \
   DEALLOC_LITERAL_INDEXED (NAME); \
 } while (0)
 
-void
-kissat_release (kissat * solver)
+static void
+release_variables (kissat * solver)
 {
-  kissat_require_initialized (solver);
-  kissat_release_heap (solver, SCORES);
-
   kissat_release_phases (solver);
 
-  RELEASE_STACK (solver->export);
-  RELEASE_STACK (solver->import);
-
   DEALLOC_VARIABLE_INDEXED (assigned);
   DEALLOC_VARIABLE_INDEXED (flags);
+  DEALLOC_VARIABLE_INDEXED (frozen);
   DEALLOC_VARIABLE_INDEXED (links);
 
   DEALLOC_LITERAL_INDEXED (marks);
   DEALLOC_LITERAL_INDEXED (values);
   DEALLOC_LITERAL_INDEXED (watches);
 
+  RELEASE_ARRAY (solver->trail, solver->size);
+}
+
+void
+kissat_release (kissat * solver)
+{
+  kissat_require_initialized (solver);
+  kissat_release_heap (solver, SCORES);
+  kissat_release_checkpoint (solver);
+  kissat_release_portfolio (solver);
+  kissat_release_sharing (solver);
+
+  RELEASE_STACK (solver->export);
+  RELEASE_STACK (solver->import);
+
+  ACCOUNT (variables, release_variables (solver));
+
   RELEASE_STACK (solver->import);
   RELEASE_STACK (solver->eliminated);
-  RELEASE_STACK (solver->extend);
+  ACCOUNT (extend, RELEASE_STACK (solver->extend));
   RELEASE_STACK (solver->witness);
   RELEASE_STACK (solver->etrail);
 
-  RELEASE_STACK (solver->vectors.stack);
+  RELEASE_STACK (solver->assumptions);
+  RELEASE_STACK (solver->assumed);
+  RELEASE_STACK (solver->failed);
+  RELEASE_STACK (solver->restored);
+
+  ACCOUNT (vectors, RELEASE_STACK (solver->vectors.stack));
+  kissat_release_defrag_vectors (solver);
   RELEASE_STACK (solver->delayed);
 
   RELEASE_STACK (solver->clause);
@@ -104,14 +127,12 @@ kissat_release (kissat * solver)
   RELEASE_STACK (solver->resolvent);
 #endif
 
-  RELEASE_STACK (solver->arena);
+  kissat_release_arena (solver);
 
   RELEASE_STACK (solver->units);
   RELEASE_STACK (solver->frames);
   RELEASE_STACK (solver->sorter);
 
-  RELEASE_ARRAY (solver->trail, solver->size);
-
   RELEASE_STACK (solver->analyzed);
   RELEASE_STACK (solver->levels);
   RELEASE_STACK (solver->minimize);
@@ -154,6 +175,10 @@ kissat_release (kissat * solver)
     if (!getenv ("LEAK"))
       kissat_fatal ("internally leaking %" PRIu64 " bytes", leaked);
 #endif
+#ifndef NDEBUG
+  for (unsigned tag = 0; tag < MEM_TAGS; tag++)
+    assert (!solver->memory.current[tag]);
+#endif
 
   kissat_free (0, solver, sizeof *solver);
 }
@@ -166,7 +191,29 @@ kissat_reserve (kissat * solver, int max_var)
 		  "negative maximum variable argument '%d'", max_var);
   kissat_require (max_var <= EXTERNAL_MAX_VAR,
 		  "invalid maximum variable argument '%d'", max_var);
-  kissat_increase_size (solver, (unsigned) max_var);
+  if (PORTFOLIO)
+    {
+      if (max_var > solver->portfolio.max_var)
+	solver->portfolio.max_var = max_var;
+    }
+  else
+    kissat_increase_size (solver, (unsigned) max_var);
+}
+
+void
+kissat_reserve_clauses (kissat * solver, size_t clauses, size_t literals)
+{
+  kissat_require_initialized (solver);
+  LOG ("reserving space for %zu clauses with %zu literals",
+       clauses, literals);
+  if (PORTFOLIO)
+    {
+      kissat_portfolio_reserve (solver, clauses, literals);
+      return;
+    }
+  kissat_reserve_arena (solver, clauses, literals);
+  const size_t entries = MAX_SIZE_T / 4 < clauses ? MAX_SIZE_T : 4 * clauses;
+  kissat_reserve_vectors (solver, entries);
 }
 
 int
@@ -227,11 +274,63 @@ kissat_set_conflict_limit (kissat * solver, unsigned limit)
        limits->conflicts, limit);
 }
 
+void
+kissat_set_memory_limit (kissat * solver, unsigned limit)
+{
+  kissat_require_initialized (solver);
+  limits *limits = &solver->limits;
+  limited *limited = &solver->limited;
+  limited->memory = true;
+  limits->memory = (uint64_t) limit << 20;
+  limits->reclaim.bytes = limits->memory / 100 * GET_OPTION (memreclaim);
+  limits->reclaim.conflicts = 0;
+  LOG ("set memory limit to %" PRIu64 " bytes (%u MB)",
+       limits->memory, limit);
+}
+
+void
+kissat_set_threads (kissat * solver, unsigned threads)
+{
+  kissat_require_initialized (solver);
+  kissat_require (threads, "zero threads");
+  kissat_require (EMPTY_STACK (solver->import) &&
+		  EMPTY_STACK (solver->portfolio.formula),
+		  "threads have to be set before adding clauses");
+#ifndef NPROOFS
+  kissat_require (!solver->proof, "can not use threads with proofs");
+#endif
+  kissat_require (!solver->checkpoint.path,
+		  "can not use threads with checkpoints");
+  solver->portfolio.threads = threads;
+  LOG ("set number of threads to %u", threads);
+}
+
+size_t
+kissat_memory_usage (kissat * solver, const char *subsystem, size_t *peak)
+{
+  kissat_require_initialized (solver);
+  const memory *memory = &solver->memory;
+  unsigned tag = MEM_TAGS;
+#define MEM(NAME) \
+  if (!strcmp (subsystem, #NAME)) \
+    tag = MEM_ ## NAME;
+  MEMS
+#undef MEM
+  if (peak)
+    *peak = tag < MEM_TAGS ? memory->peak[tag] : 0;
+  if (tag == MEM_arena)
+    return memory->current[tag] + kissat_mapped_arena_bytes (solver);
+  return tag < MEM_TAGS ? memory->current[tag] : 0;
+}
+
 void
 kissat_print_statistics (kissat * solver)
 {
 #ifndef QUIET
   kissat_require_initialized (solver);
+  kissat_print_cubes (solver);
+  if (solver->portfolio.winner)
+    solver = solver->portfolio.winner;
   const int verbosity = kissat_verbosity (solver);
   if (verbosity < 0)
     return;
@@ -264,261 +363,345 @@ kissat_print_statistics (kissat * solver)
   (void) solver;
 }
 
-void
-kissat_add (kissat * solver, int elit)
+// Before new clauses or assumptions are added after a previous call to
+// 'kissat_solve' the solver has to go back to the root level and forget
+// about the previous solution and failed assumptions.
+
+static void
+prepare_incremental (kissat * solver)
+{
+  solver->extended = false;
+  CLEAR_STACK (solver->failed);
+  if (solver->level)
+    kissat_backtrack_in_consistent_state (solver, 0);
+}
+
+static unsigned
+import_eliminated_literal (kissat * solver, int elit)
+{
+  const unsigned eidx = ABS (elit);
+  if (eidx < SIZE_STACK (solver->import))
+    {
+      const import *const import = &PEEK_STACK (solver->import, eidx);
+      if (import->imported && import->eliminated)
+	{
+	  kissat_require (GET_OPTION (incremental),
+			  "can not restore eliminated variable %u "
+			  "(option 'incremental' disabled)", eidx);
+	  kissat_restore_eliminated (solver, eidx);
+	}
+    }
+  return kissat_import_literal (solver, elit);
+}
+
+static inline unsigned
+import_added_literal (kissat * solver, int elit)
+{
+  const unsigned eidx = ABS (elit);
+  if (eidx < SIZE_STACK (solver->import))
+    {
+      const import *const import = &PEEK_STACK (solver->import, eidx);
+      if (import->imported && !import->eliminated)
+	{
+	  unsigned ilit = import->lit;
+	  if (elit < 0)
+	    ilit = NOT (ilit);
+	  assert (VALID_INTERNAL_LITERAL (ilit));
+	  return ilit;
+	}
+    }
+  return import_eliminated_literal (solver, elit);
+}
+
+static inline void
+add_literal (kissat * solver, int elit)
 {
-  kissat_require_initialized (solver);
-  kissat_require (!GET (searches), "incremental solving not supported");
 #if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
   const int checking = kissat_checking (solver);
   const bool logging = kissat_logging (solver);
   const bool proving = kissat_proving (solver);
+  if (checking || logging || proving)
+    PUSH_STACK (solver->original, elit);
 #endif
-  if (elit)
-    {
-      kissat_require_valid_external_internal (elit);
-#if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
-      if (checking || logging || proving)
-	PUSH_STACK (solver->original, elit);
-#endif
-      unsigned ilit = kissat_import_literal (solver, elit);
+  unsigned ilit = import_added_literal (solver, elit);
 
-      const mark mark = MARK (ilit);
-      if (!mark)
+  const mark mark = MARK (ilit);
+  if (!mark)
+    {
+      const value value = kissat_fixed (solver, ilit);
+      if (value > 0)
 	{
-	  const value value = kissat_fixed (solver, ilit);
-	  if (value > 0)
+	  if (!solver->clause_satisfied)
 	    {
-	      if (!solver->clause_satisfied)
-		{
-		  LOG ("adding root level satisfied literal %u(%d)@0=1",
-		       ilit, elit);
-		  solver->clause_satisfied = true;
-		}
-	    }
-	  else if (value < 0)
-	    {
-	      LOG ("adding root level falsified literal %u(%d)@0=-1",
+	      LOG ("adding root level satisfied literal %u(%d)@0=1",
 		   ilit, elit);
-	      if (!solver->clause_shrink)
-		{
-		  solver->clause_shrink = true;
-		  LOG ("thus original clause needs shrinking");
-		}
-	    }
-	  else
-	    {
-	      MARK (ilit) = 1;
-	      MARK (NOT (ilit)) = -1;
-	      assert (SIZE_STACK (solver->clause) < UINT_MAX);
-	      PUSH_STACK (solver->clause, ilit);
-	    }
-	}
-      else if (mark < 0)
-	{
-	  assert (mark < 0);
-	  if (!solver->clause_trivial)
-	    {
-	      LOG ("adding dual literal %u(%d) and %u(%d)",
-		   NOT (ilit), -elit, ilit, elit);
-	      solver->clause_trivial = true;
+	      solver->clause_satisfied = true;
 	    }
 	}
-      else
+      else if (value < 0)
 	{
-	  assert (mark > 0);
-	  LOG ("adding duplicated literal %u(%d)", ilit, elit);
+	  LOG ("adding root level falsified literal %u(%d)@0=-1",
+	       ilit, elit);
 	  if (!solver->clause_shrink)
 	    {
 	      solver->clause_shrink = true;
 	      LOG ("thus original clause needs shrinking");
 	    }
 	}
+      else
+	{
+	  MARK (ilit) = 1;
+	  MARK (NOT (ilit)) = -1;
+	  assert (SIZE_STACK (solver->clause) < UINT_MAX);
+	  PUSH_STACK (solver->clause, ilit);
+	}
+    }
+  else if (mark < 0)
+    {
+      assert (mark < 0);
+      if (!solver->clause_trivial)
+	{
+	  LOG ("adding dual literal %u(%d) and %u(%d)",
+	       NOT (ilit), -elit, ilit, elit);
+	  solver->clause_trivial = true;
+	}
     }
   else
     {
+      assert (mark > 0);
+      LOG ("adding duplicated literal %u(%d)", ilit, elit);
+      if (!solver->clause_shrink)
+	{
+	  solver->clause_shrink = true;
+	  LOG ("thus original clause needs shrinking");
+	}
+    }
+}
+
+static void
+add_clause (kissat * solver)
+{
 #if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
-      const size_t offset = solver->offset_of_last_original_clause;
-      size_t esize = SIZE_STACK (solver->original) - offset;
-      int *elits = BEGIN_STACK (solver->original) + offset;
-      assert (esize <= UINT_MAX);
+  const int checking = kissat_checking (solver);
+  const bool logging = kissat_logging (solver);
+  const bool proving = kissat_proving (solver);
+  const size_t offset = solver->offset_of_last_original_clause;
+  size_t esize = SIZE_STACK (solver->original) - offset;
+  int *elits = BEGIN_STACK (solver->original) + offset;
+  assert (esize <= UINT_MAX);
 #endif
-      ADD_UNCHECKED_EXTERNAL (esize, elits);
-      const size_t isize = SIZE_STACK (solver->clause);
-      unsigned *ilits = BEGIN_STACK (solver->clause);
-      assert (isize < (unsigned) INT_MAX);
-
-      if (solver->inconsistent)
-	LOG ("inconsistent thus skipping original clause");
-      else if (solver->clause_satisfied)
-	LOG ("skipping satisfied original clause");
-      else if (solver->clause_trivial)
-	LOG ("skipping trivial original clause");
-      else
+  ADD_UNCHECKED_EXTERNAL (esize, elits);
+  ADD_ORIGINAL_TO_PROOF (esize, elits);
+  const size_t isize = SIZE_STACK (solver->clause);
+  unsigned *ilits = BEGIN_STACK (solver->clause);
+  assert (isize < (unsigned) INT_MAX);
+
+  if (solver->inconsistent)
+    LOG ("inconsistent thus skipping original clause");
+  else if (solver->clause_satisfied)
+    LOG ("skipping satisfied original clause");
+  else if (solver->clause_trivial)
+    LOG ("skipping trivial original clause");
+  else
+    {
+      kissat_activate_literals (solver, isize, ilits);
+
+      if (!isize)
 	{
-	  kissat_activate_literals (solver, isize, ilits);
+	  if (solver->clause_shrink)
+	    LOG ("all original clause literals root level falsified");
+	  else
+	    LOG ("found empty original clause");
 
-	  if (!isize)
+	  if (!solver->inconsistent)
 	    {
-	      if (solver->clause_shrink)
-		LOG ("all original clause literals root level falsified");
-	      else
-		LOG ("found empty original clause");
-
-	      if (!solver->inconsistent)
-		{
-		  LOG ("thus solver becomes inconsistent");
-		  solver->inconsistent = true;
-		  CHECK_AND_ADD_EMPTY ();
-		  ADD_EMPTY_TO_PROOF ();
-		}
+	      LOG ("thus solver becomes inconsistent");
+	      solver->inconsistent = true;
+	      CHECK_AND_ADD_EMPTY ();
+	      ADD_EMPTY_TO_PROOF ();
 	    }
-	  else if (isize == 1)
-	    {
-	      unsigned unit = TOP_STACK (solver->clause);
+	}
+      else if (isize == 1)
+	{
+	  unsigned unit = TOP_STACK (solver->clause);
 
-	      if (solver->clause_shrink)
-		LOGUNARY (unit, "original clause shrinks to");
-	      else
-		LOGUNARY (unit, "found original");
+	  if (solver->clause_shrink)
+	    LOGUNARY (unit, "original clause shrinks to");
+	  else
+	    LOGUNARY (unit, "found original");
 
-	      kissat_original_unit (solver, unit);
+	  kissat_original_unit (solver, unit);
 
-	      COVER (solver->level);
-	      if (!solver->level)
-		(void) kissat_search_propagate (solver);
-	    }
-	  else
-	    {
-	      reference res = kissat_new_original_clause (solver);
+	  COVER (solver->level);
+	  if (!solver->level)
+	    (void) kissat_search_propagate (solver);
+	}
+      else
+	{
+	  reference res = kissat_new_original_clause (solver);
 
-	      const unsigned a = ilits[0];
-	      const unsigned b = ilits[1];
+	  const unsigned a = ilits[0];
+	  const unsigned b = ilits[1];
 
-	      const value u = VALUE (a);
-	      const value v = VALUE (b);
+	  const value u = VALUE (a);
+	  const value v = VALUE (b);
 
-	      const unsigned k = u ? LEVEL (a) : UINT_MAX;
-	      const unsigned l = v ? LEVEL (b) : UINT_MAX;
+	  const unsigned k = u ? LEVEL (a) : UINT_MAX;
+	  const unsigned l = v ? LEVEL (b) : UINT_MAX;
 
-	      bool assign = false;
+	  bool assign = false;
 
-	      if (!u && v < 0)
-		{
-		  LOG ("original clause immediately forcing");
-		  assign = true;
-		}
-	      else if (u < 0 && k == l)
-		{
-		  LOG ("both watches falsified at level @%u", k);
-		  assert (v < 0);
-		  assert (k > 0);
-		  kissat_backtrack_without_updating_phases (solver, k - 1);
-		}
-	      else if (u < 0)
-		{
-		  LOG ("watches falsified at levels @%u and @%u", k, l);
-		  assert (v < 0);
-		  assert (k > l);
-		  assert (l > 0);
-		  assign = true;
-		}
-	      else if (u > 0 && v < 0)
-		{
-		  LOG ("first watch satisfied at level @%u "
-		       "second falsified at level @%u", k, l);
-		  assert (k <= l);
-		}
-	      else if (!u && v > 0)
+	  if (!u && v < 0)
+	    {
+	      LOG ("original clause immediately forcing");
+	      assign = true;
+	    }
+	  else if (u < 0 && k == l)
+	    {
+	      LOG ("both watches falsified at level @%u", k);
+	      assert (v < 0);
+	      assert (k > 0);
+	      kissat_backtrack_without_updating_phases (solver, k - 1);
+	    }
+	  else if (u < 0)
+	    {
+	      LOG ("watches falsified at levels @%u and @%u", k, l);
+	      assert (v < 0);
+	      assert (k > l);
+	      assert (l > 0);
+	      assign = true;
+	    }
+	  else if (u > 0 && v < 0)
+	    {
+	      LOG ("first watch satisfied at level @%u "
+		   "second falsified at level @%u", k, l);
+	      assert (k <= l);
+	    }
+	  else if (!u && v > 0)
+	    {
+	      LOG ("first watch unassigned "
+		   "second falsified at level @%u", l);
+	      assign = true;
+	    }
+	  else
+	    {
+	      assert (!u);
+	      assert (!v);
+	    }
+
+	  if (assign)
+	    {
+	      assert (solver->level > 0);
+
+	      if (isize == 2)
 		{
-		  LOG ("first watch unassigned "
-		       "second falsified at level @%u", l);
-		  assign = true;
+		  assert (res == INVALID_REF);
+		  kissat_assign_binary (solver, false, a, b);
 		}
 	      else
 		{
-		  assert (!u);
-		  assert (!v);
-		}
-
-	      if (assign)
-		{
-		  assert (solver->level > 0);
-
-		  if (isize == 2)
-		    {
-		      assert (res == INVALID_REF);
-		      kissat_assign_binary (solver, false, a, b);
-		    }
-		  else
-		    {
-		      assert (res != INVALID_REF);
-		      clause *c = kissat_dereference_clause (solver, res);
-		      kissat_assign_reference (solver, a, res, c);
-		    }
+		  assert (res != INVALID_REF);
+		  clause *c = kissat_dereference_clause (solver, res);
+		  kissat_assign_reference (solver, a, res, c);
 		}
 	    }
 	}
+    }
 
 #if !defined(NDEBUG) || !defined(NPROOFS)
-      if (solver->clause_satisfied || solver->clause_trivial)
-	{
+  if (solver->clause_satisfied || solver->clause_trivial)
+    {
 #ifndef NDEBUG
-	  if (checking > 1)
-	    kissat_remove_checker_external (solver, esize, elits);
+      if (checking > 1)
+	kissat_remove_checker_external (solver, esize, elits);
 #endif
 #ifndef NPROOFS
-	  if (proving)
-	    {
-	      if (esize == 1)
-		LOG ("skipping deleting unit from proof");
-	      else
-		kissat_delete_external_from_proof (solver, esize, elits);
-	    }
-#endif
-	}
-      else if (!solver->inconsistent && solver->clause_shrink)
+      if (proving)
 	{
+	  if (esize == 1)
+	    LOG ("skipping deleting unit from proof");
+	  else
+	    kissat_delete_external_from_proof (solver, esize, elits);
+	}
+#endif
+    }
+  else if (!solver->inconsistent && solver->clause_shrink)
+    {
 #ifndef NDEBUG
-	  if (checking > 1)
-	    {
-	      kissat_check_and_add_internal (solver, isize, ilits);
-	      kissat_remove_checker_external (solver, esize, elits);
-	    }
+      if (checking > 1)
+	{
+	  kissat_check_and_add_internal (solver, isize, ilits);
+	  kissat_remove_checker_external (solver, esize, elits);
+	}
 #endif
 #ifndef NPROOFS
-	  if (proving)
-	    {
-	      kissat_add_lits_to_proof (solver, isize, ilits);
-	      kissat_delete_external_from_proof (solver, esize, elits);
-	    }
-#endif
+      if (proving)
+	{
+	  kissat_add_lits_to_proof (solver, isize, ilits);
+	  kissat_delete_external_from_proof (solver, esize, elits);
 	}
 #endif
+    }
+#endif
 
 #if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
-      if (checking)
-	{
-	  LOGINTS (esize, elits, "saved original");
-	  PUSH_STACK (solver->original, 0);
-	  solver->offset_of_last_original_clause =
-	    SIZE_STACK (solver->original);
-	}
-      else if (logging || proving)
-	{
-	  LOGINTS (esize, elits, "reset original");
-	  CLEAR_STACK (solver->original);
-	  solver->offset_of_last_original_clause = 0;
-	}
+  if (checking)
+    {
+      LOGINTS (esize, elits, "saved original");
+      PUSH_STACK (solver->original, 0);
+      solver->offset_of_last_original_clause =
+	SIZE_STACK (solver->original);
+    }
+  else if (logging || proving)
+    {
+      LOGINTS (esize, elits, "reset original");
+      CLEAR_STACK (solver->original);
+      solver->offset_of_last_original_clause = 0;
+    }
 #endif
-      for (all_stack (unsigned, lit, solver->clause))
-	  MARK (lit) = MARK (NOT (lit)) = 0;
+  for (all_stack (unsigned, lit, solver->clause))
+      MARK (lit) = MARK (NOT (lit)) = 0;
 
-      CLEAR_STACK (solver->clause);
+  CLEAR_STACK (solver->clause);
+
+  solver->clause_satisfied = false;
+  solver->clause_trivial = false;
+  solver->clause_shrink = false;
+}
+
+void
+kissat_add (kissat * solver, int elit)
+{
+  kissat_require_initialized (solver);
+  prepare_incremental (solver);
+  if (elit)
+    kissat_require_valid_external_internal (elit);
+  if (PORTFOLIO)
+    kissat_portfolio_add (solver, elit);
+  else if (elit)
+    add_literal (solver, elit);
+  else
+    add_clause (solver);
+}
 
-      solver->clause_satisfied = false;
-      solver->clause_trivial = false;
-      solver->clause_shrink = false;
+void
+kissat_add_clauses (kissat * solver, const int *lits, size_t size)
+{
+  kissat_require_initialized (solver);
+  kissat_require (!size || lits, "zero literals pointer");
+  prepare_incremental (solver);
+  const int *const end = lits + size;
+  for (const int *p = lits; p != end; p++)
+    {
+      const int elit = *p;
+      if (elit)
+	kissat_require_valid_external_internal (elit);
+      if (PORTFOLIO)
+	kissat_portfolio_add (solver, elit);
+      else if (elit)
+	add_literal (solver, elit);
+      else
+	add_clause (solver);
     }
 }
 
@@ -528,8 +711,59 @@ kissat_solve (kissat * solver)
   kissat_require_initialized (solver);
   kissat_require (EMPTY_STACK (solver->clause),
 		  "incomplete clause (terminating zero not added)");
-  kissat_require (!GET (searches), "incremental solving not supported");
-  return kissat_search (solver);
+  prepare_incremental (solver);
+  if (!EMPTY_STACK (solver->restored))
+    {
+      LOG ("adding %zu restored literals", SIZE_STACK (solver->restored));
+      ints restored = solver->restored;
+      INIT_STACK (solver->restored);
+      for (all_stack (int, elit, restored))
+	if (elit)
+	  add_literal (solver, elit);
+	else
+	  add_clause (solver);
+      RELEASE_STACK (restored);
+    }
+  const int res =
+    PORTFOLIO ? kissat_portfolio_solve (solver) : kissat_search (solver);
+  kissat_reset_assumptions (solver);
+  return res;
+}
+
+void
+kissat_assume (kissat * solver, int elit)
+{
+  kissat_require_initialized (solver);
+  kissat_require (elit, "zero literal argument");
+  kissat_require_valid_external_internal (elit);
+  prepare_incremental (solver);
+  if (PORTFOLIO)
+    {
+      PUSH_STACK (solver->assumed, elit);
+      return;
+    }
+  const unsigned ilit = import_eliminated_literal (solver, elit);
+  if (!kissat_fixed (solver, ilit))
+    kissat_activate_literal (solver, ilit);
+  solver->frozen[IDX (ilit)] = true;
+  PUSH_STACK (solver->assumptions, ilit);
+  PUSH_STACK (solver->assumed, elit);
+  LOG ("assumption %zu external %d internal %s",
+       SIZE_STACK (solver->assumptions), elit, LOGLIT (ilit));
+}
+
+int
+kissat_failed (kissat * solver, int elit)
+{
+  kissat_require_initialized (solver);
+  kissat_require (elit, "zero literal argument");
+  kissat_require_valid_external_internal (elit);
+  if (solver->portfolio.winner)
+    return kissat_failed (solver->portfolio.winner, elit);
+  for (all_stack (int, other, solver->failed))
+    if (other == elit)
+      return 1;
+  return 0;
 }
 
 void
@@ -538,6 +772,7 @@ kissat_terminate (kissat * solver)
   kissat_require_initialized (solver);
   solver->termination.flagged = ~(unsigned) 0;
   assert (solver->termination.flagged);
+  kissat_terminate_portfolio (solver);
 }
 
 void
@@ -553,6 +788,8 @@ kissat_value (kissat * solver, int elit)
 {
   kissat_require_initialized (solver);
   kissat_require_valid_external_internal (elit);
+  if (solver->portfolio.winner)
+    return kissat_value (solver->portfolio.winner, elit);
   const unsigned eidx = ABS (elit);
   if (eidx >= SIZE_STACK (solver->import))
     return 0;
@@ -578,3 +815,38 @@ kissat_value (kissat * solver, int elit)
     tmp = -tmp;
   return tmp < 0 ? -elit : elit;
 }
+
+void
+kissat_values (kissat * solver, int *values, size_t size)
+{
+  kissat_require_initialized (solver);
+  kissat_require (!size || values, "zero values pointer");
+  kissat_require (size <= EXTERNAL_MAX_VAR,
+		  "too many variables requested (%zu larger than %d)",
+		  size, EXTERNAL_MAX_VAR);
+  if (solver->portfolio.winner)
+    {
+      kissat_values (solver->portfolio.winner, values, size);
+      return;
+    }
+  if (!solver->extended && !EMPTY_STACK (solver->extend))
+    kissat_extend (solver);
+  const size_t size_import = SIZE_STACK (solver->import);
+  const size_t imported = size_import ? size_import - 1 : 0;
+  const size_t limit = size < imported ? size : imported;
+  const import *const imports = BEGIN_STACK (solver->import);
+  const value *const eliminated = BEGIN_STACK (solver->eliminated);
+  const value *const internal = solver->values;
+  for (size_t i = 0; i < limit; i++)
+    {
+      const import *const import = imports + i + 1;
+      value tmp = 0;
+      if (import->imported)
+	tmp = import->eliminated ?
+	  eliminated[import->lit] : internal[import->lit];
+      const int eidx = (int) i + 1;
+      values[i] = tmp < 0 ? -eidx : tmp > 0 ? eidx : 0;
+    }
+  for (size_t i = limit; i < size; i++)
+    values[i] = 0;
+}
@@ -6,6 +6,7 @@
 #include "assign.h"
 #include "averages.h"
 #include "check.h"
+#include "checkpoint.h"
 #include "clause.h"
 #include "cover.h"
 #include "extend.h"
@@ -17,15 +18,19 @@
 #include "kimits.h"
 #include "kissat.h"
 #include "literal.h"
+#include "memory.h"
 #include "mode.h"
 #include "options.h"
 #include "phases.h"
+#include "portfolio.h"
 #include "profile.h"
 #include "proof.h"
 #include "queue.h"
 #include "random.h"
 #include "reluctant.h"
 #include "rephase.h"
+#include "share.h"
+#include "simd.h"
 #include "stack.h"
 #include "statistics.h"
 #include "literal.h"
@@ -96,9 +101,12 @@ struct kissat
 #endif
   bool watching;
 
-  bool large_clauses_watched_after_binary_clauses;
+  unsigned simd;
 
   termination termination;
+  checkpoint checkpoint;
+  portfolio portfolio;
+  sharing *sharing;
 
   unsigned vars;
   unsigned size;
@@ -110,8 +118,14 @@ struct kissat
   extensions extend;
   unsigneds witness;
 
+  unsigneds assumptions;
+  ints assumed;
+  ints failed;
+  ints restored;
+
   assigned *assigned;
   flags *flags;
+  bool *frozen;
 
   mark *marks;
 
@@ -166,6 +180,8 @@ struct kissat
   unsigneds shadow;
 
   arena arena;
+  bool arena_mapped;
+  colds colds;
   vectors vectors;
   reference first_reducible;
   reference last_irredundant;
@@ -190,6 +206,8 @@ struct kissat
   mode mode;
 
   uint64_t ticks;
+  size_t allocated;
+  memory memory;
 
   format format;
 
@@ -256,11 +274,39 @@ kissat_assigned (kissat * solver)
   LIT != LIT ## _END; \
   ++LIT
 
+static inline cold *
+kissat_cold (kissat * solver, const clause * c)
+{
+  assert (kissat_clause_in_arena (solver, c));
+  const size_t ref = (ward *) c - BEGIN_STACK (solver->arena);
+  assert (ref < SIZE_STACK (solver->colds));
+  return BEGIN_STACK (solver->colds) + ref;
+}
+
+#define COLD(C) kissat_cold (solver, (C))
+
+static inline size_t
+kissat_actual_bytes_of_clause (kissat * solver, clause * c)
+{
+  unsigned const *p = END_LITS (c);
+  if (COLD (c)->shrunken)
+    while (*p++ != INVALID_LIT)
+      ;
+  return kissat_align_ward ((char *) p - (char *) c);
+}
+
+static inline clause *
+kissat_next_clause (kissat * solver, clause * c)
+{
+  word bytes = kissat_actual_bytes_of_clause (solver, c);
+  return (clause *) ((char *) c + bytes);
+}
+
 #define all_clauses(C) \
   clause *       C         = (clause*) BEGIN_STACK (solver->arena), \
          * const C ## _END = (clause*) END_STACK (solver->arena), \
 	 * C ## _NEXT; \
-  C != C ## _END && (C ## _NEXT = kissat_next_clause (C), true); \
+  C != C ## _END && (C ## _NEXT = kissat_next_clause (solver, C), true); \
   C = C ## _NEXT
 
 #endif
@@ -27,8 +27,15 @@ struct limits
 {
   uint64_t conflicts;
   uint64_t decisions;
+  uint64_t memory;
   uint64_t reports;
 
+  struct
+  {
+    uint64_t bytes;
+    uint64_t conflicts;
+  } reclaim;
+
   struct
   {
     uint64_t ticks;
@@ -56,6 +63,7 @@ struct limited
 {
   bool conflicts;
   bool decisions;
+  bool memory;
 };
 
 struct enabled
@@ -1,6 +1,8 @@
 #ifndef _kissat_h_INCLUDED
 #define _kissat_h_INCLUDED
 
+#include <stddef.h>
+
 typedef struct kissat kissat;
 
 // Default (partial) IPASIR interface.
@@ -10,16 +12,39 @@ kissat *kissat_init (void);
 void kissat_add (kissat * solver, int lit);
 int kissat_solve (kissat * solver);
 int kissat_value (kissat * solver, int lit);
+void kissat_assume (kissat * solver, int lit);
+int kissat_failed (kissat * solver, int lit);
 void kissat_release (kissat * solver);
 
 void kissat_set_terminate (kissat * solver,
 			   void *state, int (*terminate) (void *state));
 
+// Assumptions only hold for the next call to 'kissat_solve'.  Clauses and
+// assumptions may use variables eliminated in a previous call, which are
+// then restored.  This relies on the 'incremental' option (enabled by
+// default) and thus fails if it was disabled before that previous call.
+
 // Additional API functions.
 
 void kissat_terminate (kissat * solver);
 void kissat_reserve (kissat * solver, int max_var);
 
+// Bulk clause import.  The 'lits' array of the given 'size' holds
+// zero-terminated clauses and is equivalent to calling 'kissat_add' on
+// each element in turn (a trailing clause without zero stays open).
+// Reserving space for the expected number of clauses and literals before
+// adding them avoids repeatedly resizing the clause arena and the watches.
+
+void kissat_add_clauses (kissat * solver, const int *lits, size_t size);
+void kissat_reserve_clauses (kissat * solver,
+			     size_t clauses, size_t literals);
+
+// Bulk model extraction after a satisfiable call.  Fills 'values[i]' with
+// the same result as 'kissat_value (solver, i + 1)' for all 'i < size',
+// but extends the model only once and avoids per-call overhead.
+
+void kissat_values (kissat * solver, int *values, size_t size);
+
 const char *kissat_id (void);
 const char *kissat_version (void);
 const char *kissat_compiler (void);
@@ -37,6 +62,46 @@ int kissat_set_configuration (kissat * solver, const char *name);
 void kissat_set_conflict_limit (kissat * solver, unsigned);
 void kissat_set_decision_limit (kissat * solver, unsigned);
 
+// Unlike the conflict and decision limits, which only apply to the next
+// call, the memory limit (in megabytes) stays in place.  When it is
+// approached the solver first tries to reclaim memory (by removing learned
+// clauses and releasing buffers) and only then returns zero (unknown).
+
+void kissat_set_memory_limit (kissat * solver, unsigned megabytes);
+
+// With more than one thread (which has to be set before adding clauses)
+// 'kissat_solve' runs a portfolio of differently configured solvers on the
+// same formula in parallel and returns the result of the first one which
+// finishes.  Values and failed assumptions are then taken from that
+// solver.  Limits apply to each solver separately, except that the memory
+// limit is split evenly among them.  Setting the 'cubes' option to a
+// positive depth switches to cube-and-conquer instead (unless assumptions
+// or limits are given), which splits the formula by lookahead into cubes
+// solved by the threads as assumptions.
+
+void kissat_set_threads (kissat * solver, unsigned threads);
+
+// Current number of bytes allocated by one subsystem ('arena', 'extend',
+// 'kitten', 'other', 'variables', 'vectors' or 'walk').  Its peak is
+// stored in 'peak' unless that is zero.  Unknown names yield zero.
+
+size_t kissat_memory_usage (kissat * solver,
+			    const char *subsystem, size_t *peak);
+
+// Checkpoints save the complete solver state including learned clauses,
+// scores and phases to a file, from which a new solver (without any
+// clauses added yet) can be restored, to resume solving after preemption.
+// Checkpoints are only compatible with the same build of the solver.  Both
+// functions return zero on failure.  After restoring a checkpoint the
+// previously added clauses are still present and the solver can be used
+// as before.  With 'kissat_set_checkpoint' a checkpoint is written
+// periodically during search (the given number of seconds apart).
+
+int kissat_checkpoint (kissat * solver, const char *path);
+int kissat_restore (kissat * solver, const char *path);
+void kissat_set_checkpoint (kissat * solver,
+			    const char *path, double seconds);
+
 void kissat_print_statistics (kissat * solver);
 
 #endif
@@ -116,6 +116,22 @@ do { \
 
 #define KITTEN_TICKS (solver->statistics.kitten_ticks)
 
+// Charge all memory of an embedded 'kitten' to its own subsystem.
+
+#undef CALLOC
+#undef DEALLOC
+#undef ENLARGE_STACK
+
+#define CALLOC(P,N) \
+  ACCOUNT (kitten, (P) = kissat_calloc (solver, (N), sizeof *(P)))
+
+#define DEALLOC(P,N) \
+  ACCOUNT (kitten, kissat_dealloc (solver, (P), (N), sizeof *(P)))
+
+#define ENLARGE_STACK(S) \
+  ACCOUNT (kitten, \
+    kissat_stack_enlarge (solver, (chars*) &(S), sizeof *(S).begin))
+
 /*------------------------------------------------------------------------*/
 #endif // STAND_ALONE_KITTEN
 /*------------------------------------------------------------------------*/
@@ -1107,7 +1123,7 @@ kitten_release (kitten * kitten)
 #ifdef STAND_ALONE_KITTEN
   free (kitten);
 #else
-  kissat_free (kitten->kissat, kitten, sizeof *kitten);
+  ACCOUNT (kitten, kissat_free (solver, kitten, sizeof *kitten));
 #endif
 }
 
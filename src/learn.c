@@ -2,6 +2,7 @@
 #include "inline.h"
 #include "learn.h"
 #include "reluctant.h"
+#include "share.h"
 
 #include <inttypes.h>
 
@@ -99,7 +100,7 @@ learn_reference (kissat * solver, unsigned not_uip, unsigned glue)
   const reference ref = kissat_new_redundant_clause (solver, glue);
   assert (ref != INVALID_REF);
   clause *c = kissat_dereference_clause (solver, ref);
-  c->used = 1 + (glue <= (unsigned) GET_OPTION (tier2));
+  COLD (c)->used = 1 + (glue <= (unsigned) GET_OPTION (tier2));
   const unsigned new_level = determine_new_level (solver, jump_level);
   kissat_backtrack_after_conflict (solver, new_level);
   kissat_assign_reference (solver, not_uip, ref, c);
@@ -131,6 +132,8 @@ kissat_learn_clause (kissat * solver)
   assert (glue <= UINT_MAX);
   if (!solver->probing)
     kissat_update_learned (solver, glue, size);
+  if (solver->sharing)
+    kissat_export_shared (solver, glue);
   assert (size > 0);
   if (size == 1)
     learn_unit (solver, not_uip);
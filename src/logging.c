@@ -244,8 +244,10 @@ log_clause (kissat * solver, const clause * c)
     }
   else
     {
-      if (c->redundant)
-	printf ("redundant glue %u", c->glue);
+      if (c->redundant && kissat_clause_in_arena (solver, c))
+	printf ("redundant glue %u", COLD (c)->glue);
+      else if (c->redundant)
+	fputs ("redundant", stdout);
       else
 	fputs ("irredundant", stdout);
       printf (" size %u", c->size);
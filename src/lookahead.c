@@ -0,0 +1,159 @@
+#include "allocate.h"
+#include "backtrack.h"
+#include "decide.h"
+#include "inline.h"
+#include "lookahead.h"
+#include "proprobe.h"
+
+// Lookahead for cube-and-conquer.  The literals of the given cube (in
+// terms of external literals) are assigned as decisions on top of the
+// root-level and propagated.  If this yields a conflict the cube is
+// refuted and '20' returned.  Otherwise the most promising unassigned
+// variables are probed in both phases, where candidates are preselected
+// by the product of the number of watches of their two literals.  The
+// variable which maximizes the product of the number of literals implied
+// by its two phases is returned as external literal in 'split'.  A failed
+// literal (a phase which leads to a conflict) is returned immediately,
+// since then one of the two resulting cubes is refuted right away.  If no
+// candidate is left 'split' is set to zero.  The solver is in the same
+// root-level state afterwards as before (up to learned root-level units).
+
+static unsigned
+probe_literal (kissat * solver, unsigned lit, bool *failed)
+{
+  const size_t before = SIZE_ARRAY (solver->trail);
+  kissat_internal_assume (solver, lit);
+  clause *conflict = kissat_probing_propagate (solver, 0, false);
+  const size_t after = SIZE_ARRAY (solver->trail);
+  kissat_backtrack_without_updating_phases (solver, solver->level - 1);
+  *failed = (conflict != 0);
+  return after - before;
+}
+
+static unsigned
+select_candidates (kissat * solver, unsigned *candidates,
+		   uint64_t *scores, unsigned limit)
+{
+  const flags *const flags = solver->flags;
+  const value *const values = solver->values;
+  unsigned size = 0;
+  for (all_variables (idx))
+    {
+      if (!flags[idx].active)
+	continue;
+      const unsigned lit = LIT (idx);
+      if (values[lit])
+	continue;
+      const unsigned not_lit = NOT (lit);
+      const uint64_t pos = SIZE_WATCHES (WATCHES (lit));
+      const uint64_t neg = SIZE_WATCHES (WATCHES (not_lit));
+      const uint64_t score = (pos + 1) * (neg + 1);
+      if (size == limit && score <= scores[size - 1])
+	continue;
+      unsigned i = size < limit ? size++ : size - 1;
+      while (i && scores[i - 1] < score)
+	{
+	  scores[i] = scores[i - 1];
+	  candidates[i] = candidates[i - 1];
+	  i--;
+	}
+      scores[i] = score;
+      candidates[i] = idx;
+    }
+  return size;
+}
+
+static unsigned
+lookahead_literal (kissat * solver)
+{
+  const unsigned limit = GET_OPTION (cubecandidates);
+  unsigned *candidates = kissat_nalloc (solver, limit, sizeof *candidates);
+  uint64_t *scores = kissat_nalloc (solver, limit, sizeof *scores);
+  const unsigned size = select_candidates (solver, candidates,
+					   scores, limit);
+  LOG ("selected %u lookahead candidates", size);
+  unsigned res = INVALID_LIT;
+  uint64_t best = 0;
+  for (unsigned i = 0; i < size; i++)
+    {
+      const unsigned idx = candidates[i];
+      const unsigned lit = LIT (idx);
+      const unsigned not_lit = NOT (lit);
+      bool failed;
+      const uint64_t pos = probe_literal (solver, lit, &failed);
+      if (failed)
+	{
+	  LOG ("failed lookahead literal %s", LOGLIT (lit));
+	  res = lit;
+	  break;
+	}
+      const uint64_t neg = probe_literal (solver, not_lit, &failed);
+      if (failed)
+	{
+	  LOG ("failed lookahead literal %s", LOGLIT (not_lit));
+	  res = not_lit;
+	  break;
+	}
+      const uint64_t score = pos * neg;
+      if (res != INVALID_LIT && score <= best)
+	continue;
+      res = pos < neg ? not_lit : lit;
+      best = score;
+    }
+  kissat_dealloc (solver, scores, limit, sizeof *scores);
+  kissat_dealloc (solver, candidates, limit, sizeof *candidates);
+  return res;
+}
+
+int
+kissat_lookahead (kissat * solver, size_t size, const int *cube,
+		  int *split)
+{
+  *split = 0;
+  if (solver->inconsistent)
+    return 20;
+  assert (!solver->probing);
+  solver->probing = true;
+  kissat_backtrack_propagate_and_flush_trail (solver);
+  const size_t imported = SIZE_STACK (solver->import);
+  int res = 0;
+  for (size_t i = 0; !res && i < size; i++)
+    {
+      const int elit = cube[i];
+      const unsigned eidx = ABS (elit);
+      if (eidx >= imported)
+	continue;
+      const import *const import = &PEEK_STACK (solver->import, eidx);
+      if (!import->imported || import->eliminated)
+	continue;
+      unsigned ilit = import->lit;
+      if (elit < 0)
+	ilit = NOT (ilit);
+      const value value = VALUE (ilit);
+      if (value > 0)
+	continue;
+      if (value < 0)
+	res = 20;
+      else
+	{
+	  kissat_internal_assume (solver, ilit);
+	  if (kissat_probing_propagate (solver, 0, true))
+	    res = 20;
+	}
+    }
+  if (res)
+    LOG ("lookahead cube of size %zu refuted", size);
+  else if (solver->unassigned)
+    {
+      const unsigned lit = lookahead_literal (solver);
+      if (lit != INVALID_LIT)
+	{
+	  *split = kissat_export_literal (solver, lit);
+	  LOG ("lookahead split literal %s", LOGLIT (lit));
+	}
+    }
+  if (solver->level)
+    kissat_backtrack_without_updating_phases (solver, 0);
+  solver->probing = false;
+  return res;
+}
@@ -0,0 +1,11 @@
+#ifndef _lookahead_h_INCLUDED
+#define _lookahead_h_INCLUDED
+
+#include <stddef.h>
+
+struct kissat;
+
+int kissat_lookahead (struct kissat *, size_t size, const int *cube,
+		      int *split);
+
+#endif
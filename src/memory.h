@@ -0,0 +1,47 @@
+#ifndef _memory_h_INCLUDED
+#define _memory_h_INCLUDED
+
+#include <stdlib.h>
+
+// Allocated bytes are accounted per subsystem.  Each allocation and
+// deallocation is charged to the current tag, which is 'other' unless the
+// allocation site is wrapped in 'ACCOUNT'.  Thus all sites allocating or
+// releasing memory of a tagged subsystem have to be wrapped.
+
+#define MEMS \
+MEM(other) \
+MEM(arena) \
+MEM(extend) \
+MEM(kitten) \
+MEM(variables) \
+MEM(vectors) \
+MEM(walk) \
+
+typedef struct memory memory;
+
+enum memtag
+{
+#define MEM(NAME) \
+  MEM_ ## NAME,
+  MEMS
+#undef MEM
+  MEM_TAGS
+};
+
+struct memory
+{
+  unsigned tag;
+  size_t current[MEM_TAGS];
+  size_t peak[MEM_TAGS];
+};
+
+#define ACCOUNT(NAME,STATEMENT) \
+do { \
+  memory *const ACCOUNTED_MEMORY = &solver->memory; \
+  const unsigned SAVED_MEMORY_TAG = ACCOUNTED_MEMORY->tag; \
+  ACCOUNTED_MEMORY->tag = MEM_ ## NAME; \
+  STATEMENT; \
+  ACCOUNTED_MEMORY->tag = SAVED_MEMORY_TAG; \
+} while (0)
+
+#endif
@@ -6,6 +6,7 @@
 
 #define OPTIONS \
 OPTION( ands, 1, 0, 1, "extract and eliminate and gates") \
+OPTION( arenamap, 1, 0, 1, "reserve address space for large arenas") \
 OPTION( backbone, 1, 0, 2, "binary clause backbone (2=eager)") \
 OPTION( backboneeffort, 20, 0, 1e5, "effort in per mille") \
 OPTION( backbonemaxrounds, 1e3, 1, INT_MAX, "maximum backbone rounds") \
@@ -19,12 +20,18 @@ OPTION( chrono, 1, 0, 1, "allow chronological backtracking") \
 OPTION( chronolevels, 100, 0, INT_MAX, "maximum jumped over levels") \
 OPTION( compact, 1, 0, 1, "enable compacting garbage collection") \
 OPTION( compactlim, 10, 0, 100, "compact inactive limit (in percent)") \
+OPTION( compactorder, 0, 0, 1, "renumber variables in clause graph order") \
+OPTION( cubecandidates, 32, 1, 1e4, "lookahead candidate variables") \
+OPTION( cubeconflicts, 1e4, 1, INT_MAX, "conflicts per cube before split") \
+OPTION( cubes, 0, 0, 20, "cube-and-conquer depth (0=portfolio)") \
 OPTION( decay, 50, 1, 200, "per mille scores decay") \
 OPTION( definitioncores, 2, 1, 100, "how many cores") \
 OPTION( definitions, 1, 0, 1, "extract general definitions") \
 OPTION( definitionticks, 1e6, 0, INT_MAX, "kitten ticks limits") \
+OPTION( defragincr, 1, 0, 1, "incremental defragmentation during search") \
 OPTION( defraglim, 75, 50, 100, "usable defragmentation limit in percent") \
 OPTION( defragsize, 1<<18, 10, INT_MAX, "size defragmentation limit") \
+OPTION( defragslice, 1<<18, 1, INT_MAX, "defragmentation step size") \
 OPTION( eliminate, 1, 0, 1, "bounded variable elimination (BVE)") \
 OPTION( eliminatebound, 16 ,0 , 1<<13, "maximum elimination bound") \
 OPTION( eliminateclslim, 100, 1, INT_MAX, "elimination clause size limit") \
@@ -41,15 +48,18 @@ OPTION( extract, 1, 0, 1, "extract gates in variable elimination") \
 OPTION( forcephase, 0, 0, 1, "force initial phase") \
 OPTION( forward, 1, 0, 1, "forward subsumption in BVE") \
 OPTION( forwardeffort, 100, 0, 1e6, "effort in per mille") \
+OPTION( hugepages, 1, 0, 1, "transparent huge pages for large blocks") \
 OPTION( ifthenelse, 1, 0, 1, "extract and eliminate if-then-else gates") \
-OPTION( incremental, 0, 0, 1, "enable incremental solving") \
+OPTION( incremental, 1, 0, 1, "enable incremental solving") \
 LOGOPT( log, 0, 0, 5, "logging level (1=on,2=more,3=check,4/5=mem)") \
+OPTION( memreclaim, 90, 10, 100, "reclaim memory at percent of limit") \
 OPTION( mineffort, 10, 0, INT_MAX, "minimum absolute effort in millions") \
 OPTION( minimize, 1, 0, 1, "learned clause minimization") \
 OPTION( minimizedepth, 1e3, 1, 1e6, "minimization depth") \
 OPTION( minimizeticks, 1, 0, 1, "count ticks in minimize and shrink") \
 OPTION( modeinit, 1e3, 10, 1e8, "initial focused conflicts limit") \
 OPTION( otfs, 1, 0, 1, "on-the-fly strengthening") \
+OPTION( parsethreads, 1, 1, 64, "number of DIMACS parser threads") \
 OPTION( phase, 1, 0, 1, "initial decision phase") \
 OPTION( phasesaving, 1, 0, 1, "enable phase saving") \
 OPTION( probe, 1, 0, 1, "enable probing") \
@@ -57,6 +67,8 @@ OPTION( probeinit, 100, 0, INT_MAX, "initial probing interval") \
 OPTION( probeint, 100, 2, INT_MAX, "probing interval") \
 NQTOPT( profile, 2, 0, 4, "profile level") \
 OPTION( promote, 1, 0, 1, "promote clauses") \
+OPTION( proofbuffer, 1024, 1, 1e6, "proof thread buffer size in KB") \
+OPTION( proofthread, 1, 0, 1, "write proofs in background thread") \
 NQTOPT( quiet, 0, 0, 1, "disable all messages") \
 OPTION( reduce, 1, 0, 1, "learned clause reduction") \
 OPTION( reducefraction, 75, 10, 100, "reduce fraction in percent") \
@@ -72,7 +84,11 @@ OPTION( restart, 1, 0, 1, "enable restarts") \
 OPTION( restartint, RESTARTINT_DEFAULT, 1, 1e4, "base restart interval") \
 OPTION( restartmargin, 10, 0, 25, "fast/slow margin in percent") \
 OPTION( seed, 0, 0, INT_MAX, "random seed") \
+OPTION( share, 1, 0, 1, "share learned clauses between threads") \
+OPTION( shareglue, 2, 1, 1e3, "maximum glue of shared clauses") \
+OPTION( sharesize, 8, 1, 16, "maximum size of shared clauses") \
 OPTION( shrink, 3, 0, 3, "learned clauses (1=bin,2=lrg,3=rec)") \
+OPTION( simd, 1, 0, 1, "vectorized replacement watch search") \
 OPTION( simplify, 1, 0, 1, "enable probing and elimination") \
 OPTION( stable, STABLE_DEFAULT, 0, 2, "enable stable search mode") \
 NQTOPT( statistics, 0, 0, 1, "print complete statistics") \
@@ -91,6 +107,7 @@ OPTION( sweepmaxdepth, 2, 1, INT_MAX, "maximum environment depth") \
 OPTION( sweepmaxvars, 128, 2, INT_MAX, "maximum environment variables") \
 OPTION( sweepvars, 128, 0, INT_MAX, "environment variables") \
 OPTION( target, TARGET_DEFAULT, 0, 2, "target phases (1=stable,2=focused)") \
+OPTION( ternary, 0, 0, 1, "inline ternary clauses in watches") \
 OPTION( tier1, 2, 1, 100, "learned clause tier one glue limit") \
 OPTION( tier2, 6, 1,1e3, "learned clause tier two glue limit") \
 OPTION( tumble, 1, 0, 1, "tumbled external indices order") \
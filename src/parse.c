@@ -7,6 +7,11 @@
 
 #include <ctype.h>
 #include <inttypes.h>
+#include <string.h>
+
+#ifdef _POSIX_C_SOURCE
+#include <pthread.h>
+#endif
 
 static int
 next (file * file, uint64_t * lineno_ptr)
@@ -33,16 +38,430 @@ nonl (int ch, const char *str, uint64_t * lineno_ptr)
 
 #define TRY_RELAXED_PARSING "(try '--relaxed' parsing)"
 
+// Binary CNF files start with this signature followed by the maximum
+// variable and the number of clauses.  Then the literals of each clause
+// follow, each encoded as in binary DRAT proofs, i.e., the unsigned
+// number '2*idx+sign' in 7-bit little endian chunks where the high bit
+// of a byte is set if more bytes follow.  Clauses are terminated by zero.
+
+static const unsigned char binary_cnf_signature[] = {
+  0x7f, 'B', 'C', 'N', 'F', 0, 0, 1
+};
+
+static void
+write_binary_number (file * output, uint64_t x)
+{
+  while (x & ~(uint64_t) 0x7f)
+    {
+      kissat_putc (output, (x & 0x7f) | 0x80);
+      x >>= 7;
+    }
+  kissat_putc (output, (unsigned char) x);
+}
+
+static void
+write_binary_header (file * output, int variables, uint64_t clauses)
+{
+  for (size_t i = 0; i < sizeof binary_cnf_signature; i++)
+    kissat_putc (output, binary_cnf_signature[i]);
+  write_binary_number (output, variables);
+  write_binary_number (output, clauses);
+}
+
+static inline void
+add_literal (kissat * solver, file * output, int lit)
+{
+  if (output)
+    {
+      assert (lit != INT_MIN);
+      write_binary_number (output, lit ? 2u * ABS (lit) + (lit < 0) : 0);
+    }
+  else
+    kissat_add (solver, lit);
+}
+
+// For memory mapped and internally decompressed files the bulk of the
+// clauses is scanned directly from the file buffer.  This fast path only
+// consumes white space, comments terminated by a new-line and literals
+// which are followed by white space and which are valid in the given
+// parsing mode.  It stops in front of anything else (carriage-returns,
+// overflowing literals, end-of-file etc.) and leaves it to the generic
+// character based code below, which then reports errors with exactly the
+// same message and line number as without buffering.
+
+static inline bool
+white_space (unsigned char ch)
+{
+  return ch == ' ' || ch == '\n' || ch == '\t';
+}
+
+// Returns a pointer to the white space character following the literal
+// token starting at 'p' or zero if it has to be parsed by generic code.
+
+static inline const unsigned char *
+scan_literal (const unsigned char *p, const unsigned char *end, int *lit_ptr)
+{
+  assert (p != end);
+  int sign = 1;
+  if (*p == '-')
+    {
+      if (++p == end || *p < '1' || '9' < *p)
+	return 0;
+      sign = -1;
+    }
+  else if (*p < '0' || '9' < *p)
+    return 0;
+  int idx = *p++ - '0';
+  unsigned digit;
+  while (p != end && (digit = *p - (unsigned) '0') < 10)
+    {
+      if (EXTERNAL_MAX_VAR / 10 < idx)
+	return 0;
+      idx *= 10;
+      if (EXTERNAL_MAX_VAR - (int) digit < idx)
+	return 0;
+      idx += digit;
+      p++;
+    }
+  if (p == end || !white_space (*p))
+    return 0;
+  *lit_ptr = sign * idx;
+  return p;
+}
+
+static inline const unsigned char *
+scan_comment (const unsigned char *p, const unsigned char *end)
+{
+  assert (p != end);
+  assert (*p == 'c');
+  return memchr (p, '\n', end - p);
+}
+
+static void
+scan_buffered_literals (kissat * solver, strictness strict,
+			file * file, struct file *output,
+			uint64_t * lineno_ptr, int variables, uint64_t clauses,
+			uint64_t * parsed_ptr, int *lit_ptr)
+{
+  const unsigned char *const start = file->pos;
+  const unsigned char *const end = file->end;
+  const unsigned char *p = start;
+  const bool relaxed = (strict == RELAXED_PARSING);
+  uint64_t lineno = *lineno_ptr;
+  uint64_t parsed = *parsed_ptr;
+  int lit = *lit_ptr;
+  for (;;)
+    {
+      while (p != end && white_space (*p))
+	if (*p++ == '\n')
+	  lineno++;
+      if (p == end)
+	break;
+      const unsigned char *q;
+      if (*p == 'c')
+	{
+	  if (!(q = scan_comment (p, end)))
+	    break;
+	  lineno++;
+	  p = q + 1;
+	  continue;
+	}
+      int tmp;
+      if (!(q = scan_literal (p, end, &tmp)))
+	break;
+      if (!relaxed && ABS (tmp) > variables)
+	break;
+      if (!tmp)
+	{
+	  if (!relaxed && parsed == clauses)
+	    break;
+	  parsed++;
+	}
+      lit = tmp;
+      if (*q == '\n')
+	lineno++;
+      p = q + 1;
+      add_literal (solver, output, lit);
+    }
+  file->bytes += p - start;
+  file->pos = p;
+  *lineno_ptr = lineno;
+  *parsed_ptr = parsed;
+  *lit_ptr = lit;
+}
+
+#ifdef _POSIX_C_SOURCE
+
+// With more than one parser thread the mapped clause body is split into
+// chunks at new-lines (which are always token boundaries, since comments
+// end at new-lines too).  The chunks are scanned concurrently into
+// per-thread literal buffers and then added in their original order, so
+// clauses spanning chunk boundaries, clause identifiers and proofs are
+// the same as with sequential parsing.  A chunk is scanned with the same
+// restrictions as above.  If a chunk is not scanned completely, or would
+// exceed the number of clauses in the header, we fall back to sequential
+// parsing from where the previous chunk stopped.
+
+#define MAX_PARSE_CHUNK (1u << 24)
+
+typedef struct chunk chunk;
+
+struct chunk
+{
+  const unsigned char *begin;
+  const unsigned char *end;
+  const unsigned char *stopped;
+  int *lits;
+  int *end_of_lits;
+  size_t capacity;
+  uint64_t lines;
+  uint64_t zeros;
+  int variables;
+  bool relaxed;
+};
+
+static void *
+scan_chunk (void *ptr)
+{
+  chunk *chunk = ptr;
+  const unsigned char *p = chunk->begin;
+  const unsigned char *const end = chunk->end;
+  const int variables = chunk->variables;
+  const bool relaxed = chunk->relaxed;
+  int *lits = chunk->lits;
+  uint64_t lines = 0, zeros = 0;
+  for (;;)
+    {
+      while (p != end && white_space (*p))
+	if (*p++ == '\n')
+	  lines++;
+      if (p == end)
+	break;
+      const unsigned char *q;
+      if (*p == 'c')
+	{
+	  if (!(q = scan_comment (p, end)))
+	    break;
+	  lines++;
+	  p = q + 1;
+	  continue;
+	}
+      int lit;
+      if (!(q = scan_literal (p, end, &lit)))
+	break;
+      if (!relaxed && ABS (lit) > variables)
+	break;
+      if (!lit)
+	zeros++;
+      assert (lits < chunk->lits + chunk->capacity);
+      *lits++ = lit;
+      if (*q == '\n')
+	lines++;
+      p = q + 1;
+    }
+  chunk->stopped = p;
+  chunk->end_of_lits = lits;
+  chunk->lines = lines;
+  chunk->zeros = zeros;
+  return 0;
+}
+
+static const unsigned char *
+next_line (const unsigned char *p, const unsigned char *end)
+{
+  assert (p < end);
+  const unsigned char *q = memchr (p, '\n', end - p);
+  return q ? q + 1 : end;
+}
+
+static void
+parse_chunks_in_parallel (kissat * solver, strictness strict,
+			  file * file, struct file *output, unsigned threads,
+			  uint64_t * lineno_ptr, int variables, uint64_t clauses,
+			  uint64_t * parsed_ptr, int *lit_ptr)
+{
+  kissat_verbose (solver, "parsing clauses with %u threads", threads);
+  chunk *chunks = kissat_calloc (solver, threads, sizeof *chunks);
+  pthread_t *ids = kissat_calloc (solver, threads, sizeof *ids);
+  bool *started = kissat_calloc (solver, threads, sizeof *started);
+  const bool relaxed = (strict == RELAXED_PARSING);
+  uint64_t lineno = *lineno_ptr;
+  uint64_t parsed = *parsed_ptr;
+  int lit = *lit_ptr;
+  bool done = false;
+  while (!done && file->pos != file->end)
+    {
+      const size_t remaining = file->end - file->pos;
+      size_t window = remaining;
+      if (window / threads > MAX_PARSE_CHUNK)
+	window = threads * (size_t) MAX_PARSE_CHUNK;
+      const size_t target = window / threads + 1;
+      const unsigned char *begin = file->pos;
+      for (unsigned i = 0; i < threads; i++)
+	{
+	  chunk *c = chunks + i;
+	  const size_t left = file->end - begin;
+	  const unsigned char *end;
+	  if (left <= target || (i + 1 == threads && window == remaining))
+	    end = file->end;
+	  else
+	    end = next_line (begin + target, file->end);
+	  c->begin = begin;
+	  c->end = end;
+	  const size_t capacity = (end - begin) / 2 + 1;
+	  if (c->capacity < capacity)
+	    {
+	      DEALLOC (c->lits, c->capacity);
+	      NALLOC (c->lits, capacity);
+	      c->capacity = capacity;
+	    }
+	  c->variables = variables;
+	  c->relaxed = relaxed;
+	  begin = end;
+	}
+      for (unsigned i = 1; i < threads; i++)
+	started[i] = !pthread_create (ids + i, 0, scan_chunk, chunks + i);
+      scan_chunk (chunks);
+      for (unsigned i = 1; i < threads; i++)
+	if (started[i])
+	  pthread_join (ids[i], 0);
+	else
+	  scan_chunk (chunks + i);
+      for (unsigned i = 0; !done && i < threads; i++)
+	{
+	  chunk *c = chunks + i;
+	  if (!relaxed && clauses - parsed < c->zeros)
+	    {
+	      done = true;
+	      break;
+	    }
+	  for (const int *p = c->lits; p != c->end_of_lits; p++)
+	    add_literal (solver, output, (lit = *p));
+	  parsed += c->zeros;
+	  lineno += c->lines;
+	  file->bytes += c->stopped - c->begin;
+	  file->pos = c->stopped;
+	  if (c->stopped != c->end)
+	    done = true;
+	}
+    }
+  for (unsigned i = 0; i < threads; i++)
+    DEALLOC (chunks[i].lits, chunks[i].capacity);
+  kissat_dealloc (solver, started, threads, sizeof *started);
+  kissat_dealloc (solver, ids, threads, sizeof *ids);
+  kissat_dealloc (solver, chunks, threads, sizeof *chunks);
+  *lineno_ptr = lineno;
+  *parsed_ptr = parsed;
+  *lit_ptr = lit;
+}
+
+#endif
+
+// Reads the remaining bytes of a number in binary encoding after its first
+// byte 'ch' and returns 'false' on unexpected end-of-file.  Numbers which
+// do not fit into 64 bits are saturated to 'UINT64_MAX'.
+
+static bool
+read_binary_number (file * file, int ch, uint64_t * res_ptr)
+{
+  assert (ch != EOF);
+  uint64_t res = ch & 0x7f;
+  unsigned shift = 7;
+  while (ch & 0x80)
+    {
+      if ((ch = kissat_getc (file)) == EOF)
+	return false;
+      const uint64_t bits = ch & 0x7f;
+      if (shift >= 64 || (bits << shift) >> shift != bits)
+	res = UINT64_MAX;
+      else if (res != UINT64_MAX)
+	res |= bits << shift;
+      shift += 7;
+    }
+  *res_ptr = res;
+  return true;
+}
+
+static const char *
+parse_binary_cnf (kissat * solver, strictness strict, file * file,
+		  struct file *output, uint64_t * lineno_ptr, int *max_var_ptr)
+{
+  for (size_t i = 1; i < sizeof binary_cnf_signature; i++)
+    if (kissat_getc (file) != binary_cnf_signature[i])
+      return "invalid binary CNF signature";
+  uint64_t tmp;
+  int ch = kissat_getc (file);
+  if (ch == EOF || !read_binary_number (file, ch, &tmp))
+    return "unexpected end-of-file in binary CNF header";
+  if (tmp > EXTERNAL_MAX_VAR)
+    return "maximum variable too large";
+  const int variables = tmp;
+  uint64_t clauses;
+  ch = kissat_getc (file);
+  if (ch == EOF || !read_binary_number (file, ch, &clauses))
+    return "unexpected end-of-file in binary CNF header";
+  if (clauses == UINT64_MAX)
+    return "number of clauses too large";
+  kissat_message (solver,
+		  "parsed binary CNF header with %d variables "
+		  "and %" PRIu64 " clauses", variables, clauses);
+  *max_var_ptr = variables;
+  if (output)
+    write_binary_header (output, variables, clauses);
+  else
+    kissat_reserve (solver, variables);
+  const bool relaxed = (strict == RELAXED_PARSING);
+  uint64_t parsed = 0;
+  int lit = 0;
+  while ((ch = kissat_getc (file)) != EOF)
+    {
+      if (!read_binary_number (file, ch, &tmp))
+	return "unexpected end-of-file in binary literal";
+      if (tmp)
+	{
+	  const uint64_t idx = tmp / 2;
+	  if (!idx)
+	    return "invalid binary literal encoding";
+	  if (idx > EXTERNAL_MAX_VAR)
+	    return "variable index too large";
+	  if (!relaxed && idx > (uint64_t) variables)
+	    return "maximum variable index exceeded " TRY_RELAXED_PARSING;
+	  lit = (tmp & 1) ? -(int) idx : (int) idx;
+	}
+      else
+	{
+	  if (!relaxed && parsed == clauses)
+	    return "too many clauses " TRY_RELAXED_PARSING;
+	  parsed++;
+	  lit = 0;
+	  *lineno_ptr += 1;
+	}
+      add_literal (solver, output, lit);
+    }
+  if (lit)
+    return "trailing zero missing";
+  if (!relaxed && parsed < clauses)
+    {
+      if (parsed + 1 == clauses)
+	return "one clause missing " TRY_RELAXED_PARSING;
+      return "more than one clause missing " TRY_RELAXED_PARSING;
+    }
+  return 0;
+}
+
 static const char *
 parse_dimacs (kissat * solver, strictness strict,
-	      file * file, uint64_t * lineno_ptr, int *max_var_ptr)
+	      file * file, struct file *output,
+	      uint64_t * lineno_ptr, int *max_var_ptr)
 {
   *lineno_ptr = 1;
   bool first = true;
-  int ch;
-  for (;;)
+  int ch = NEXT ();
+  if (ch == binary_cnf_signature[0])
+    return parse_binary_cnf (solver, strict, file, output,
+			     lineno_ptr, max_var_ptr);
+  for (;; ch = NEXT ())
     {
-      ch = NEXT ();
       if (ch == 'p')
 	break;
       else if (ch == EOF)
@@ -273,11 +692,23 @@ parse_dimacs (kissat * solver, strictness strict,
   kissat_message (solver,
 		  "parsed 'p cnf %d %" PRIu64 "' header", variables, clauses);
   *max_var_ptr = variables;
-  kissat_reserve (solver, variables);
+  if (output)
+    write_binary_header (output, variables, clauses);
+  else
+    kissat_reserve (solver, variables);
   uint64_t parsed = 0;
   int lit = 0;
+#ifdef _POSIX_C_SOURCE
+  const unsigned threads = GET_OPTION (parsethreads);
+  if (file->map && threads > 1)
+    parse_chunks_in_parallel (solver, strict, file, output, threads,
+			      lineno_ptr, variables, clauses, &parsed, &lit);
+#endif
   for (;;)
     {
+      if (file->pos != file->end)
+	scan_buffered_literals (solver, strict, file, output, lineno_ptr,
+				variables, clauses, &parsed, &lit);
       ch = NEXT ();
       if (ch == ' ')
 	continue;
@@ -381,7 +812,7 @@ parse_dimacs (kissat * solver, strictness strict,
 	  parsed++;
 	  lit = 0;
 	}
-      kissat_add (solver, lit);
+      add_literal (solver, output, lit);
     }
   if (lit)
     return "trailing zero missing";
@@ -394,6 +825,19 @@ parse_dimacs (kissat * solver, strictness strict,
   return 0;
 }
 
+static const char *
+check_decompression (file * file, const char *res)
+{
+#ifdef BUILTIN_DECOMPRESSION
+  const char *error = kissat_decompression_error (file);
+  if (error)
+    return error;
+#else
+  (void) file;
+#endif
+  return res;
+}
+
 const char *
 kissat_parse_dimacs (kissat * solver,
 		     strictness strict,
@@ -401,9 +845,23 @@ kissat_parse_dimacs (kissat * solver,
 {
   const char *res;
   START (parse);
-  res = parse_dimacs (solver, strict, file, lineno_ptr, max_var_ptr);
+  res = parse_dimacs (solver, strict, file, 0, lineno_ptr, max_var_ptr);
+  res = check_decompression (file, res);
   if (!solver->inconsistent)
     kissat_defrag_watches (solver);
   STOP (parse);
   return res;
 }
+
+const char *
+kissat_write_binary_cnf (kissat * solver, strictness strict,
+			 file * file, struct file *output,
+			 uint64_t * lineno_ptr, int *max_var_ptr)
+{
+  const char *res;
+  START (parse);
+  res = parse_dimacs (solver, strict, file, output, lineno_ptr, max_var_ptr);
+  res = check_decompression (file, res);
+  STOP (parse);
+  return res;
+}
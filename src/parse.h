@@ -17,4 +17,8 @@ struct kissat;
 const char *kissat_parse_dimacs (struct kissat *, strictness, file *,
 				 uint64_t * linenoptr, int *max_var_ptr);
 
+const char *kissat_write_binary_cnf (struct kissat *, strictness,
+				     file *, file * output,
+				     uint64_t * linenoptr, int *max_var_ptr);
+
 #endif
@@ -0,0 +1,353 @@
+#include "allocate.h"
+#include "cube.h"
+#include "error.h"
+#include "internal.h"
+#include "logging.h"
+#include "print.h"
+#include "require.h"
+
+#include <limits.h>
+
+#ifdef _POSIX_C_SOURCE
+#include <pthread.h>
+#endif
+
+// In portfolio mode (with more than one thread) clauses added to the
+// solver are only recorded as external literals in 'formula' but not added
+// to the solver itself.  Each call to 'kissat_solve' creates one fresh
+// worker solver per thread.  The workers import the same formula, which
+// is shared read-only between them, concurrently and are diversified by
+// seed, configuration, initial phase and search mode.  The first worker
+// finishing with a result wins and terminates the others.  It is kept
+// until the next call to provide values, failed assumptions and
+// statistics through the portfolio solver.  Unless disabled by the
+// 'share' option the workers exchange short learned clauses (see
+// 'share.c') during solving.
+
+typedef struct race race;
+typedef struct worker worker;
+
+struct worker
+{
+  kissat *solver;
+  race *race;
+  unsigned id;
+  int res;
+#ifdef _POSIX_C_SOURCE
+  pthread_t thread;
+  bool started;
+#endif
+};
+
+struct race
+{
+  const portfolio *portfolio;
+  const ints *assumed;
+  worker *workers;
+  unsigned threads;
+  unsigned winner;
+#ifdef _POSIX_C_SOURCE
+  pthread_mutex_t lock;
+#endif
+};
+
+void
+kissat_init_portfolio (kissat * solver)
+{
+#ifdef _POSIX_C_SOURCE
+  pthread_mutex_init (&solver->portfolio.lock, 0);
+#else
+  (void) solver;
+#endif
+}
+
+void
+kissat_portfolio_add (kissat * solver, int elit)
+{
+  portfolio *portfolio = &solver->portfolio;
+  PUSH_STACK (portfolio->formula, elit);
+  if (!elit)
+    portfolio->clauses++;
+  else if (ABS (elit) > portfolio->max_var)
+    portfolio->max_var = ABS (elit);
+}
+
+void
+kissat_portfolio_reserve (kissat * solver, size_t clauses, size_t literals)
+{
+  ints *formula = &solver->portfolio.formula;
+  const size_t size = SIZE_STACK (*formula);
+  const size_t capacity = CAPACITY_STACK (*formula);
+  const size_t limit = MAX_SIZE_T / sizeof (int) - size;
+  if (clauses > limit || literals > limit - clauses)
+    return;
+  const size_t needed = size + clauses + literals;
+  if (needed <= capacity)
+    return;
+  LOG ("reserving portfolio formula space for %zu literals", needed);
+  formula->begin =
+    kissat_nrealloc (solver, formula->begin, capacity, needed, sizeof (int));
+  formula->end = formula->begin + size;
+  formula->allocated = formula->begin + needed;
+}
+
+#ifndef NOPTIONS
+
+// The first worker runs with the options of the portfolio solver.  The
+// others apply one of the following strategies on top of them (the
+// configuration first) and all workers use different random seeds.
+
+typedef struct strategy strategy;
+
+struct strategy
+{
+  const char *configuration;
+  const char *option;
+  int value;
+};
+
+static const strategy strategies[] = {
+  {"default", 0, 0},
+  {"sat", 0, 0},
+  {"unsat", 0, 0},
+  {"default", "phase", 0},
+  {"default", "stable", 0},
+  {"sat", "phase", 0},
+  {"default", "target", 2},
+  {"plain", 0, 0},
+};
+
+#define STRATEGIES (sizeof strategies / sizeof *strategies)
+
+static void
+diversify (kissat * solver, kissat * worker, unsigned id)
+{
+  worker->options = solver->options;
+  const strategy *strategy = strategies + id % STRATEGIES;
+  kissat_set_configuration (worker, strategy->configuration);
+  if (strategy->option)
+    kissat_set_option (worker, strategy->option, strategy->value);
+  const unsigned seed = (unsigned) GET_OPTION (seed) + id;
+  kissat_set_option (worker, "seed", (int) (seed & INT_MAX));
+#ifndef QUIET
+  if (id)
+    kissat_set_option (worker, "quiet", 1);
+#endif
+}
+
+#endif
+
+kissat *
+kissat_new_portfolio_worker (kissat * solver, unsigned id, unsigned threads)
+{
+  kissat *worker = kissat_init ();
+#ifndef NOPTIONS
+  diversify (solver, worker, id);
+#else
+  (void) id;
+#endif
+  const limited *limited = &solver->limited;
+  const limits *limits = &solver->limits;
+  if (limited->conflicts)
+    kissat_set_conflict_limit (worker, (unsigned) limits->conflicts);
+  if (limited->decisions)
+    kissat_set_decision_limit (worker, (unsigned) limits->decisions);
+  if (limited->memory)
+    kissat_set_memory_limit (worker,
+			     (unsigned) ((limits->memory >> 20) / threads));
+  return worker;
+}
+
+static void
+finish (race * race, unsigned id)
+{
+#ifdef _POSIX_C_SOURCE
+  pthread_mutex_lock (&race->lock);
+#endif
+  const bool won = (race->winner == race->threads);
+  if (won)
+    race->winner = id;
+#ifdef _POSIX_C_SOURCE
+  pthread_mutex_unlock (&race->lock);
+#endif
+  if (!won)
+    return;
+  for (unsigned i = 0; i < race->threads; i++)
+    if (i != id)
+      kissat_terminate (race->workers[i].solver);
+}
+
+void
+kissat_load_portfolio_formula (kissat * worker, const portfolio * portfolio)
+{
+  const ints *formula = &portfolio->formula;
+  const size_t size = SIZE_STACK (*formula);
+  kissat_reserve (worker, portfolio->max_var);
+  kissat_reserve_clauses (worker, portfolio->clauses,
+			  size - portfolio->clauses);
+  kissat_add_clauses (worker, BEGIN_STACK (*formula), size);
+}
+
+static void *
+run_worker (void *ptr)
+{
+  worker *worker = ptr;
+  race *race = worker->race;
+  kissat *solver = worker->solver;
+  kissat_load_portfolio_formula (solver, race->portfolio);
+  for (all_stack (int, elit, *race->assumed))
+    kissat_assume (solver, elit);
+  const int res = kissat_solve (solver);
+  worker->res = res;
+  if (res)
+    finish (race, worker->id);
+  return 0;
+}
+
+static void
+release_winner (kissat * solver)
+{
+  portfolio *portfolio = &solver->portfolio;
+  if (!portfolio->winner)
+    return;
+  kissat_release (portfolio->winner);
+  portfolio->winner = 0;
+}
+
+int
+kissat_portfolio_solve (kissat * solver)
+{
+  portfolio *portfolio = &solver->portfolio;
+  kissat_require (EMPTY_STACK (portfolio->formula) ||
+		  !TOP_STACK (portfolio->formula),
+		  "incomplete clause (terminating zero not added)");
+  release_winner (solver);
+  if (kissat_cubing (solver))
+    return kissat_cube_and_conquer (solver);
+  const unsigned threads = portfolio->threads;
+  kissat_verbose (solver, "solving %zu clauses with %u threads",
+		  portfolio->clauses, threads);
+  race race;
+  race.portfolio = portfolio;
+  race.assumed = &solver->assumed;
+  race.threads = threads;
+  race.winner = threads;
+  race.workers = kissat_calloc (solver, threads, sizeof *race.workers);
+  kissat **solvers = kissat_calloc (solver, threads, sizeof *solvers);
+  for (unsigned id = 0; id < threads; id++)
+    {
+      worker *worker = race.workers + id;
+      worker->solver = solvers[id] =
+	kissat_new_portfolio_worker (solver, id, threads);
+      worker->race = &race;
+      worker->id = id;
+    }
+  exchange *exchange = 0;
+  if (GET_OPTION (share))
+    {
+      exchange = kissat_new_exchange (solver);
+      for (unsigned id = 0; id < threads; id++)
+	kissat_connect_sharing (solvers[id], exchange, id);
+    }
+  kissat_set_portfolio_workers (solver, solvers);
+#ifdef _POSIX_C_SOURCE
+  pthread_mutex_init (&race.lock, 0);
+  for (unsigned id = 1; id < threads; id++)
+    {
+      worker *worker = race.workers + id;
+      worker->started =
+	!pthread_create (&worker->thread, 0, run_worker, worker);
+    }
+  run_worker (race.workers);
+  for (unsigned id = 1; id < threads; id++)
+    {
+      worker *worker = race.workers + id;
+      if (worker->started)
+	pthread_join (worker->thread, 0);
+      else if (race.winner == threads)
+	run_worker (worker);
+    }
+  pthread_mutex_destroy (&race.lock);
+#else
+  for (unsigned id = 0; race.winner == threads && id < threads; id++)
+    run_worker (race.workers + id);
+#endif
+  kissat_set_portfolio_workers (solver, 0);
+  if (exchange)
+    {
+      for (unsigned id = 0; id < threads; id++)
+	kissat_release_sharing (solvers[id]);
+      kissat_delete_exchange (solver, exchange);
+    }
+  const unsigned winner = race.winner < threads ? race.winner : 0;
+  const int res = race.workers[winner].res;
+  for (unsigned id = 0; id < threads; id++)
+    if (id != winner)
+      kissat_release (solvers[id]);
+  portfolio->winner = solvers[winner];
+#if !defined(QUIET) && !defined(NOPTIONS)
+  kissat_set_option (portfolio->winner, "quiet", GET_OPTION (quiet));
+#endif
+  kissat_dealloc (solver, solvers, threads, sizeof *solvers);
+  kissat_dealloc (solver, race.workers, threads, sizeof *race.workers);
+  if (res)
+    kissat_verbose (solver, "thread %u won with result %d", winner, res);
+  else
+    kissat_verbose (solver, "no thread succeeded");
+  solver->limited.conflicts = false;
+  solver->limited.decisions = false;
+  solver->termination.flagged = 0;
+  return res;
+}
+
+// The workers are published and retracted under the portfolio lock,
+// which is also held while terminating them.  Thus they are not released
+// while being terminated.  Termination might be triggered by a signal
+// handler though and thus only tries to get the lock.  If that fails the
+// lock is either held by another terminating thread (which terminates the
+// workers anyhow), or the workers are currently retracted (and do not
+// have to be terminated anymore), or they are currently published, in
+// which case the termination flag is checked afterwards.
+
+void
+kissat_set_portfolio_workers (kissat * solver, kissat ** workers)
+{
+  portfolio *portfolio = &solver->portfolio;
+#ifdef _POSIX_C_SOURCE
+  pthread_mutex_lock (&portfolio->lock);
+#endif
+  portfolio->workers = workers;
+#ifdef _POSIX_C_SOURCE
+  pthread_mutex_unlock (&portfolio->lock);
+#endif
+  if (workers && solver->termination.flagged)
+    kissat_terminate_portfolio (solver);
+}
+
+void
+kissat_terminate_portfolio (kissat * solver)
+{
+  portfolio *portfolio = &solver->portfolio;
+#ifdef _POSIX_C_SOURCE
+  if (pthread_mutex_trylock (&portfolio->lock))
+    return;
+#endif
+  kissat **workers = portfolio->workers;
+  if (workers)
+    for (unsigned i = 0; i < portfolio->threads; i++)
+      kissat_terminate (workers[i]);
+#ifdef _POSIX_C_SOURCE
+  pthread_mutex_unlock (&portfolio->lock);
+#endif
+}
+
+void
+kissat_release_portfolio (kissat * solver)
+{
+  release_winner (solver);
+  RELEASE_STACK (solver->portfolio.cubes);
+  RELEASE_STACK (solver->portfolio.formula);
+#ifdef _POSIX_C_SOURCE
+  pthread_mutex_destroy (&solver->portfolio.lock);
+#endif
+}
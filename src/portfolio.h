@@ -0,0 +1,46 @@
+#ifndef _portfolio_h_INCLUDED
+#define _portfolio_h_INCLUDED
+
+#include "cube.h"
+#include "stack.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef _POSIX_C_SOURCE
+#include <pthread.h>
+#endif
+
+typedef struct portfolio portfolio;
+
+struct kissat;
+
+struct portfolio
+{
+  unsigned threads;
+  int max_var;
+  size_t clauses;
+  ints formula;
+  struct kissat **volatile workers;
+  struct kissat *winner;
+  conquereds cubes;
+#ifdef _POSIX_C_SOURCE
+  pthread_mutex_t lock;
+#endif
+};
+
+#define PORTFOLIO (solver->portfolio.threads > 1)
+
+void kissat_init_portfolio (struct kissat *);
+void kissat_portfolio_add (struct kissat *, int elit);
+void kissat_portfolio_reserve (struct kissat *, size_t clauses,
+			       size_t literals);
+struct kissat *kissat_new_portfolio_worker (struct kissat *,
+					    unsigned id, unsigned threads);
+void kissat_load_portfolio_formula (struct kissat *, const portfolio *);
+void kissat_set_portfolio_workers (struct kissat *, struct kissat **);
+int kissat_portfolio_solve (struct kissat *);
+void kissat_terminate_portfolio (struct kissat *);
+void kissat_release_portfolio (struct kissat *);
+
+#endif
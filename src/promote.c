@@ -9,7 +9,7 @@ kissat_promote_clause (kissat * solver, clause * c, unsigned new_glue)
     return;
   assert (!c->keep);
   assert (c->redundant);
-  const unsigned old_glue = c->glue;
+  const unsigned old_glue = COLD (c)->glue;
   assert (new_glue < old_glue);
   const unsigned tier1 = GET_OPTION (tier1);
   const unsigned tier2 = MAX (GET_OPTION (tier2), GET_OPTION (tier1));
@@ -27,7 +27,7 @@ kissat_promote_clause (kissat * solver, clause * c, unsigned new_glue)
       assert (tier1 < new_glue && new_glue <= tier2);
       LOGCLS (c, "promoting with new glue %u to tier2", new_glue);
       INC (clauses_promoted2);
-      c->used = 2;
+      COLD (c)->used = 2;
     }
   else if (old_glue <= tier2)
     {
@@ -44,7 +44,7 @@ kissat_promote_clause (kissat * solver, clause * c, unsigned new_glue)
       LOGCLS (c, "keeping with new glue %u in tier3", new_glue);
     }
   INC (clauses_improved);
-  c->glue = new_glue;
+  COLD (c)->glue = new_glue;
 #ifndef LOGGING
   (void) solver;
 #endif
@@ -3,23 +3,90 @@
 #include "allocate.h"
 #include "file.h"
 #include "inline.h"
+#include "print.h"
+#include "sort.h"
 
 #undef NDEBUG
 
-#ifndef NDEBUG
 #include <string.h>
+
+#ifdef _POSIX_C_SOURCE
+#include <pthread.h>
 #endif
 
+// With the 'proofthread' option enabled proof lines are not written to
+// the file directly but collected in one of two large buffers (of size
+// 'proofbuffer' kilobytes).  Whenever the current buffer is full it is
+// handed over to a background thread which writes it in one go, while the
+// solver continues to fill the other buffer.  Only this hand-over requires
+// synchronization.
+
+#ifdef _POSIX_C_SOURCE
+
+typedef struct writer writer;
+
+struct writer
+{
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  unsigned char *buffers[2];
+  unsigned char *pos, *end;
+  size_t size;
+  unsigned current;
+  size_t pending;
+  bool stop;
+};
+
+#endif
+
+// In FRAT mode every proof line carries a clause identifier.  Original
+// clauses are traced as 'o' lines, added clauses as 'a' lines, deleted
+// clauses as 'd' lines and the clauses still alive at the end as 'f'
+// lines.  The solver does not keep identifiers in its clauses.  Instead we
+// map the sorted external literals of each live clause to its identifier
+// in a hash table local to the proof.  Learned clauses and derived root
+// level units are further annotated with the identifiers of the antecedents
+// used to derive them ('l' hints in RUP order), which allows 'frat-rs' to
+// elaborate the proof to LRAT cheaply.  Hints are optional in FRAT, thus
+// lemmas derived during inprocessing are traced without them.
+
+typedef struct identified identified;
+typedef STACK (uint64_t) identifiers;
+
+struct identified
+{
+  identified *next;
+  uint64_t id;
+  unsigned hash;
+  unsigned size;
+  int lits[];
+};
+
 struct proof
 {
   kissat *solver;
   bool binary;
+  bool frat;
   file *file;
+#ifdef _POSIX_C_SOURCE
+  writer *writer;
+#endif
   ints line;
   uint64_t added;
   uint64_t deleted;
   uint64_t lines;
   uint64_t literals;
+  uint64_t id;
+  size_t identified;
+  size_t hashed;
+  identified **table;
+  identifiers hints;
+  ints sorted;
+  unsigneds positions;
+  unsigneds touched;
+  bool *marked;
+  size_t size_marked;
 #ifndef NDEBUG
   bool empty;
   char *units;
@@ -40,17 +107,128 @@ struct proof
 #define LOGLINE3(...) \
   LOGINTS3 (SIZE_STACK (proof->line), BEGIN_STACK (proof->line), __VA_ARGS__)
 
+#ifdef _POSIX_C_SOURCE
+
+static void *
+write_proof_buffers (void *ptr)
+{
+  proof *proof = ptr;
+  writer *writer = proof->writer;
+  FILE *file = proof->file->file;
+  pthread_mutex_lock (&writer->lock);
+  for (;;)
+    {
+      while (!writer->pending && !writer->stop)
+	pthread_cond_wait (&writer->cond, &writer->lock);
+      const size_t size = writer->pending;
+      if (!size)
+	break;
+      const unsigned char *buffer = writer->buffers[!writer->current];
+      pthread_mutex_unlock (&writer->lock);
+      fwrite (buffer, 1, size, file);
+      pthread_mutex_lock (&writer->lock);
+      writer->pending = 0;
+      pthread_cond_broadcast (&writer->cond);
+    }
+  pthread_mutex_unlock (&writer->lock);
+  return 0;
+}
+
+static void
+hand_over_proof_buffer (writer * writer)
+{
+  unsigned char *buffer = writer->buffers[writer->current];
+  const size_t size = writer->pos - buffer;
+  pthread_mutex_lock (&writer->lock);
+  while (writer->pending)
+    pthread_cond_wait (&writer->cond, &writer->lock);
+  if (size)
+    {
+      writer->pending = size;
+      writer->current = !writer->current;
+      buffer = writer->buffers[writer->current];
+      writer->pos = buffer;
+      writer->end = buffer + writer->size;
+      pthread_cond_broadcast (&writer->cond);
+    }
+  pthread_mutex_unlock (&writer->lock);
+}
+
+static void
+start_proof_writer (kissat * solver, proof * proof)
+{
+  writer *writer = kissat_calloc (solver, 1, sizeof *writer);
+  const size_t size = (size_t) GET_OPTION (proofbuffer) << 10;
+  for (unsigned i = 0; i < 2; i++)
+    writer->buffers[i] = kissat_malloc (solver, size);
+  writer->pos = writer->buffers[0];
+  writer->end = writer->pos + size;
+  writer->size = size;
+  pthread_mutex_init (&writer->lock, 0);
+  pthread_cond_init (&writer->cond, 0);
+  proof->writer = writer;
+  if (!pthread_create (&writer->thread, 0, write_proof_buffers, proof))
+    {
+      LOG ("started background proof writer thread");
+      return;
+    }
+  kissat_warning (solver, "failed to start proof writer thread");
+  pthread_cond_destroy (&writer->cond);
+  pthread_mutex_destroy (&writer->lock);
+  for (unsigned i = 0; i < 2; i++)
+    kissat_free (solver, writer->buffers[i], writer->size);
+  kissat_free (solver, writer, sizeof *writer);
+  proof->writer = 0;
+}
+
+static void
+stop_proof_writer (kissat * solver, proof * proof)
+{
+  writer *writer = proof->writer;
+  hand_over_proof_buffer (writer);
+  pthread_mutex_lock (&writer->lock);
+  writer->stop = true;
+  pthread_cond_broadcast (&writer->cond);
+  pthread_mutex_unlock (&writer->lock);
+  pthread_join (writer->thread, 0);
+  LOG ("stopped background proof writer thread");
+  fflush (proof->file->file);
+  pthread_cond_destroy (&writer->cond);
+  pthread_mutex_destroy (&writer->lock);
+  for (unsigned i = 0; i < 2; i++)
+    kissat_free (solver, writer->buffers[i], writer->size);
+  kissat_free (solver, writer, sizeof *writer);
+  proof->writer = 0;
+}
+
+#endif
+
+static void finalize_identified_clauses (proof *);
+
 void
-kissat_init_proof (kissat * solver, file * file, bool binary)
+kissat_init_proof (kissat * solver, file * file, bool binary, bool frat)
 {
   assert (file);
   assert (!solver->proof);
+  assert (!binary || !frat);
   proof *proof = kissat_calloc (solver, 1, sizeof (struct proof));
   proof->binary = binary;
+  proof->frat = frat;
   proof->file = file;
   proof->solver = solver;
   solver->proof = proof;
-  LOG ("starting to trace %s proof", binary ? "binary" : "non-binary");
+  if (frat)
+    {
+      proof->hashed = 1u << 10;
+      proof->table = kissat_calloc (solver, proof->hashed,
+				    sizeof *proof->table);
+    }
+  LOG ("starting to trace %s%s proof",
+       binary ? "binary" : "non-binary", frat ? " FRAT" : "");
+#ifdef _POSIX_C_SOURCE
+  if (GET_OPTION (proofthread) && file->close)
+    start_proof_writer (solver, proof);
+#endif
 }
 
 void
@@ -59,7 +237,18 @@ kissat_release_proof (kissat * solver)
   proof *proof = solver->proof;
   assert (proof);
   LOG ("stopping to trace proof");
+  if (proof->frat)
+    finalize_identified_clauses (proof);
+#ifdef _POSIX_C_SOURCE
+  if (proof->writer)
+    stop_proof_writer (solver, proof);
+#endif
   RELEASE_STACK (proof->line);
+  RELEASE_STACK (proof->hints);
+  RELEASE_STACK (proof->sorted);
+  RELEASE_STACK (proof->positions);
+  RELEASE_STACK (proof->touched);
+  kissat_dealloc (solver, proof->marked, proof->size_marked, 1);
 #ifndef NDEBUG
   kissat_free (solver, proof->units, proof->size_units);
 #endif
@@ -97,6 +286,23 @@ kissat_print_proof_statistics (kissat * solver, bool verbose)
 
 #endif
 
+static inline void
+write_proof_character (proof * proof, int ch)
+{
+#ifdef _POSIX_C_SOURCE
+  writer *writer = proof->writer;
+  if (writer)
+    {
+      if (writer->pos == writer->end)
+	hand_over_proof_buffer (writer);
+      *writer->pos++ = ch;
+      proof->file->bytes++;
+      return;
+    }
+#endif
+  kissat_putc (proof->file, ch);
+}
+
 static void
 import_internal_proof_literal (kissat * solver, proof * proof, unsigned ilit)
 {
@@ -166,62 +372,287 @@ print_binary_proof_line (proof * proof)
       while (x & ~0x7f)
 	{
 	  ch = (x & 0x7f) | 0x80;
-	  kissat_putc (proof->file, ch);
+	  write_proof_character (proof, ch);
 	  x >>= 7;
 	}
-      kissat_putc (proof->file, (unsigned char) x);
+      write_proof_character (proof, (unsigned char) x);
     }
-  kissat_putc (proof->file, 0);
+  write_proof_character (proof, 0);
 }
 
 static void
-print_non_binary_proof_line (proof * proof)
+write_proof_number (proof * proof, uint64_t number)
 {
-  assert (!proof->binary);
-  char buffer[16];
+  char buffer[24];
   char *end_of_buffer = buffer + sizeof buffer;
-  *--end_of_buffer = 0;
+  char *p = end_of_buffer;
+  do
+    *--p = '0' + (number % 10);
+  while (number /= 10);
+  while (p != end_of_buffer)
+    write_proof_character (proof, *p++);
+}
+
+static void
+write_proof_literals (proof * proof)
+{
   for (all_stack (int, elit, proof->line))
     {
-      char *p = end_of_buffer;
-      assert (!*p);
       assert (elit);
       assert (elit != INT_MIN);
       unsigned eidx;
       if (elit < 0)
 	{
-	  kissat_putc (proof->file, '-');
+	  write_proof_character (proof, '-');
 	  eidx = -elit;
 	}
       else
 	eidx = elit;
-      for (unsigned tmp = eidx; tmp; tmp /= 10)
-	*--p = '0' + (tmp % 10);
-      while (p != end_of_buffer)
-	kissat_putc (proof->file, *p++);
-      kissat_putc (proof->file, ' ');
+      write_proof_number (proof, eidx);
+      write_proof_character (proof, ' ');
     }
-  kissat_putc (proof->file, '0');
-  kissat_putc (proof->file, '\n');
+  write_proof_character (proof, '0');
 }
 
 static void
-print_proof_line (proof * proof)
+print_non_binary_proof_line (proof * proof)
+{
+  assert (!proof->binary);
+  write_proof_literals (proof);
+  write_proof_character (proof, '\n');
+}
+
+static void
+finish_proof_line (proof * proof)
 {
-  proof->lines++;
-  if (proof->binary)
-    print_binary_proof_line (proof);
-  else
-    print_non_binary_proof_line (proof);
   CLEAR_STACK (proof->line);
 #if !defined(NDEBUG) || defined(LOGGING)
   CLEAR_STACK (proof->imported);
 #endif
 #ifndef NDEBUG
-  fflush (proof->file->file);
+#ifdef _POSIX_C_SOURCE
+  if (!proof->writer)
+#endif
+    fflush (proof->file->file);
 #endif
 }
 
+static void
+print_proof_line (proof * proof)
+{
+  proof->lines++;
+  if (proof->binary)
+    print_binary_proof_line (proof);
+  else
+    print_non_binary_proof_line (proof);
+  finish_proof_line (proof);
+}
+
+static void
+print_frat_proof_line (proof * proof, int type, uint64_t id)
+{
+  assert (proof->frat);
+  assert (!proof->binary);
+  proof->lines++;
+  write_proof_character (proof, type);
+  write_proof_character (proof, ' ');
+  write_proof_number (proof, id);
+  write_proof_character (proof, ' ');
+  write_proof_literals (proof);
+  if (type == 'a' && !EMPTY_STACK (proof->hints))
+    {
+      write_proof_character (proof, ' ');
+      write_proof_character (proof, 'l');
+      for (all_stack (uint64_t, hint, proof->hints))
+	{
+	  write_proof_character (proof, ' ');
+	  write_proof_number (proof, hint);
+	}
+      write_proof_character (proof, ' ');
+      write_proof_character (proof, '0');
+    }
+  write_proof_character (proof, '\n');
+  finish_proof_line (proof);
+}
+
+static inline bool
+less_int (int a, int b)
+{
+  return a < b;
+}
+
+static inline bool
+less_unsigned (unsigned a, unsigned b)
+{
+  return a < b;
+}
+
+static unsigned
+sort_and_hash_literals (proof * proof)
+{
+  kissat *solver = proof->solver;
+  SORT_STACK (int, proof->sorted, less_int);
+  unsigned res = 0;
+  for (all_stack (int, elit, proof->sorted))
+    res = (res + (unsigned) elit) * 2654435761u;
+  return res;
+}
+
+static void
+copy_sorted_proof_line (proof * proof)
+{
+  kissat *solver = proof->solver;
+  CLEAR_STACK (proof->sorted);
+  for (all_stack (int, elit, proof->line))
+    PUSH_STACK (proof->sorted, elit);
+}
+
+static identified **
+find_identified (proof * proof, unsigned hash)
+{
+  const size_t size = SIZE_STACK (proof->sorted);
+  const int *const lits = BEGIN_STACK (proof->sorted);
+  const size_t bytes = size * sizeof *lits;
+  identified **p = proof->table + (hash & (proof->hashed - 1)), *c;
+  while ((c = *p))
+    {
+      if (c->hash == hash && c->size == size && !memcmp (c->lits, lits, bytes))
+	break;
+      p = &c->next;
+    }
+  return p;
+}
+
+static void
+resize_identified (proof * proof)
+{
+  kissat *solver = proof->solver;
+  const size_t old_hashed = proof->hashed;
+  const size_t new_hashed = 2 * old_hashed;
+  identified **table = kissat_calloc (solver, new_hashed, sizeof *table);
+  for (size_t i = 0; i < old_hashed; i++)
+    for (identified * c = proof->table[i], *next; c; c = next)
+      {
+	next = c->next;
+	identified **p = table + (c->hash & (new_hashed - 1));
+	c->next = *p;
+	*p = c;
+      }
+  kissat_dealloc (solver, proof->table, old_hashed, sizeof *table);
+  proof->table = table;
+  proof->hashed = new_hashed;
+  LOG ("resized FRAT identifier table to %zu entries", new_hashed);
+}
+
+static size_t
+bytes_identified (unsigned size)
+{
+  return sizeof (identified) + size * sizeof (int);
+}
+
+static void
+identify_proof_line (proof * proof, uint64_t id)
+{
+  if (proof->identified == proof->hashed)
+    resize_identified (proof);
+  copy_sorted_proof_line (proof);
+  const unsigned hash = sort_and_hash_literals (proof);
+  const size_t size = SIZE_STACK (proof->sorted);
+  assert (size <= UINT_MAX);
+  kissat *solver = proof->solver;
+  identified *c = kissat_malloc (solver, bytes_identified (size));
+  c->id = id;
+  c->hash = hash;
+  c->size = size;
+  memcpy (c->lits, BEGIN_STACK (proof->sorted), size * sizeof (int));
+  identified **p = proof->table + (hash & (proof->hashed - 1));
+  c->next = *p;
+  *p = c;
+  proof->identified++;
+}
+
+static uint64_t
+unidentify_proof_line (proof * proof)
+{
+  copy_sorted_proof_line (proof);
+  const unsigned hash = sort_and_hash_literals (proof);
+  identified **p = find_identified (proof, hash), *c = *p;
+  if (!c)
+    return 0;
+  *p = c->next;
+  const uint64_t res = c->id;
+  kissat *solver = proof->solver;
+  kissat_free (solver, c, bytes_identified (c->size));
+  assert (proof->identified);
+  proof->identified--;
+  return res;
+}
+
+static uint64_t
+find_internal_identifier (proof * proof, size_t size, const unsigned *ilits)
+{
+  kissat *solver = proof->solver;
+  CLEAR_STACK (proof->sorted);
+  for (size_t i = 0; i < size; i++)
+    PUSH_STACK (proof->sorted, kissat_export_literal (solver, ilits[i]));
+  const unsigned hash = sort_and_hash_literals (proof);
+  identified *c = *find_identified (proof, hash);
+  return c ? c->id : 0;
+}
+
+static bool
+hint_internal_clause (proof * proof, size_t size, const unsigned *ilits)
+{
+  const uint64_t id = find_internal_identifier (proof, size, ilits);
+  if (!id)
+    return false;
+  kissat *solver = proof->solver;
+  PUSH_STACK (proof->hints, id);
+  return true;
+}
+
+static bool
+hint_internal_unit (proof * proof, unsigned ilit)
+{
+  return hint_internal_clause (proof, 1, &ilit);
+}
+
+static bool
+hint_internal_binary (proof * proof, unsigned a, unsigned b)
+{
+  const unsigned ilits[2] = { a, b };
+  return hint_internal_clause (proof, 2, ilits);
+}
+
+static void
+finalize_identified_clauses (proof * proof)
+{
+  kissat *solver = proof->solver;
+  LOG ("finalizing %zu FRAT clauses", proof->identified);
+  for (size_t i = 0; i < proof->hashed; i++)
+    for (identified * c = proof->table[i], *next; c; c = next)
+      {
+	next = c->next;
+	assert (EMPTY_STACK (proof->line));
+	for (unsigned j = 0; j < c->size; j++)
+	  PUSH_STACK (proof->line, c->lits[j]);
+	print_frat_proof_line (proof, 'f', c->id);
+	kissat_free (solver, c, bytes_identified (c->size));
+      }
+  kissat_dealloc (solver, proof->table, proof->hashed, sizeof *proof->table);
+  proof->table = 0;
+  proof->identified = proof->hashed = 0;
+}
+
+static void
+print_identified_proof_line (proof * proof, int type)
+{
+  const uint64_t id = ++proof->id;
+  identify_proof_line (proof, id);
+  print_frat_proof_line (proof, type, id);
+  CLEAR_STACK (proof->hints);
+}
+
 #ifndef NDEBUG
 
 static unsigned
@@ -283,9 +714,14 @@ print_added_proof_line (proof * proof)
 #ifndef NDEBUG
   check_repeated_proof_lines (proof);
 #endif
-  if (proof->binary)
-    kissat_putc (proof->file, 'a');
-  print_proof_line (proof);
+  if (proof->frat)
+    print_identified_proof_line (proof, 'a');
+  else
+    {
+      if (proof->binary)
+	write_proof_character (proof, 'a');
+      print_proof_line (proof);
+    }
 }
 
 static void
@@ -298,9 +734,21 @@ print_delete_proof_line (proof * proof)
     LOGIMPORTED3 ("added internal proof line");
   LOGLINE3 ("deleted external proof line");
 #endif
-  kissat_putc (proof->file, 'd');
+  if (proof->frat)
+    {
+      const uint64_t id = unidentify_proof_line (proof);
+      if (id)
+	print_frat_proof_line (proof, 'd', id);
+      else
+	{
+	  LOGLINE3 ("skipping unidentified deleted proof line");
+	  finish_proof_line (proof);
+	}
+      return;
+    }
+  write_proof_character (proof, 'd');
   if (!proof->binary)
-    kissat_putc (proof->file, ' ');
+    write_proof_character (proof, ' ');
   print_proof_line (proof);
 }
 
@@ -340,16 +788,160 @@ kissat_add_lits_to_proof (kissat * solver, size_t size, const unsigned *ilits)
   print_added_proof_line (proof);
 }
 
+static void
+hint_root_level_unit (kissat * solver, proof * proof, unsigned ilit)
+{
+  if (VALUE (ilit) <= 0)
+    return;
+  const assigned *const a = ASSIGNED (ilit);
+  if (a->level)
+    return;
+  if (a->reason == UNIT_REASON || a->reason == DECISION_REASON)
+    return;
+  bool complete;
+  if (a->binary)
+    complete = hint_internal_unit (proof, NOT (a->reason)) &&
+      hint_internal_binary (proof, ilit, a->reason);
+  else
+    {
+      complete = true;
+      const clause *const reason =
+	kissat_dereference_clause (solver, a->reason);
+      const unsigned *const end = reason->lits + reason->size;
+      for (const unsigned *p = reason->lits; complete && p != end; p++)
+	if (*p != ilit)
+	  complete = hint_internal_unit (proof, NOT (*p));
+      if (complete)
+	complete = hint_internal_clause (proof, reason->size, reason->lits);
+    }
+  if (!complete)
+    CLEAR_STACK (proof->hints);
+}
+
 void
 kissat_add_unit_to_proof (kissat * solver, unsigned ilit)
 {
   proof *proof = solver->proof;
   assert (proof);
   assert (EMPTY_STACK (proof->line));
+  if (proof->frat && EMPTY_STACK (proof->hints))
+    hint_root_level_unit (solver, proof, ilit);
   import_internal_proof_literal (solver, proof, ilit);
   print_added_proof_line (proof);
 }
 
+void
+kissat_add_original_to_proof (kissat * solver, size_t size, const int *elits)
+{
+  proof *proof = solver->proof;
+  assert (proof);
+  if (!proof->frat)
+    return;
+  LOGINTS3 (size, elits, "original");
+  import_external_proof_literals (solver, proof, size, elits);
+  print_identified_proof_line (proof, 'o');
+}
+
+static void
+mark_hinted_variable (proof * proof, unsigned idx)
+{
+  kissat *solver = proof->solver;
+  proof->marked[idx] = true;
+  PUSH_STACK (proof->touched, idx);
+}
+
+static bool
+hint_learned_literal (kissat * solver, proof * proof, unsigned lit)
+{
+  const unsigned idx = IDX (lit);
+  if (proof->marked[idx])
+    return true;
+  mark_hinted_variable (proof, idx);
+  const assigned *const a = solver->assigned + idx;
+  if (!a->level)
+    return hint_internal_unit (proof, NOT (lit));
+  if (a->reason == DECISION_REASON)
+    return false;
+  PUSH_STACK (proof->positions, a->trail);
+  return true;
+}
+
+void
+kissat_add_learned_hints_to_proof (kissat * solver, const clause * conflict)
+{
+  proof *proof = solver->proof;
+  assert (proof);
+  if (!proof->frat)
+    return;
+  assert (EMPTY_STACK (proof->hints));
+  assert (EMPTY_STACK (proof->positions));
+  assert (EMPTY_STACK (proof->touched));
+  const size_t vars = solver->vars;
+  if (proof->size_marked < vars)
+    {
+      kissat_dealloc (solver, proof->marked, proof->size_marked, 1);
+      proof->marked = kissat_calloc (solver, vars, 1);
+      proof->size_marked = vars;
+    }
+  for (all_stack (unsigned, lit, solver->clause))
+    mark_hinted_variable (proof, IDX (lit));
+  bool complete = true;
+  const unsigned *const end_conflict = conflict->lits + conflict->size;
+  for (const unsigned *p = conflict->lits; complete && p != end_conflict; p++)
+    complete = hint_learned_literal (solver, proof, *p);
+  const assigned *const all_assigned = solver->assigned;
+  for (size_t i = 0; complete && i < SIZE_STACK (proof->positions); i++)
+    {
+      const unsigned pos = PEEK_STACK (proof->positions, i);
+      const unsigned lit = PEEK_ARRAY (solver->trail, pos);
+      const assigned *const a = all_assigned + IDX (lit);
+      assert (a->level);
+      assert (a->reason != DECISION_REASON);
+      if (a->binary)
+	complete = hint_learned_literal (solver, proof, a->reason);
+      else
+	{
+	  const clause *const reason =
+	    kissat_dereference_clause (solver, a->reason);
+	  const unsigned *const end = reason->lits + reason->size;
+	  for (const unsigned *p = reason->lits; complete && p != end; p++)
+	    if (*p != lit)
+	      complete = hint_learned_literal (solver, proof, *p);
+	}
+    }
+  if (complete)
+    {
+      SORT_STACK (unsigned, proof->positions, less_unsigned);
+      for (all_stack (unsigned, pos, proof->positions))
+	{
+	  const unsigned lit = PEEK_ARRAY (solver->trail, pos);
+	  const assigned *const a = all_assigned + IDX (lit);
+	  if (a->binary)
+	    complete = hint_internal_binary (proof, lit, a->reason);
+	  else
+	    {
+	      const clause *const reason =
+		kissat_dereference_clause (solver, a->reason);
+	      complete = hint_internal_clause (proof, reason->size,
+					       reason->lits);
+	    }
+	  if (!complete)
+	    break;
+	}
+    }
+  if (complete)
+    complete = hint_internal_clause (proof, conflict->size, conflict->lits);
+  if (!complete)
+    {
+      LOG ("could not determine antecedents of learned clause");
+      CLEAR_STACK (proof->hints);
+    }
+  for (all_stack (unsigned, idx, proof->touched))
+    proof->marked[idx] = false;
+  CLEAR_STACK (proof->positions);
+  CLEAR_STACK (proof->touched);
+}
+
 void
 kissat_shrink_clause_in_proof (kissat * solver, const clause * c,
 			       unsigned remove, unsigned keep)
@@ -11,7 +11,8 @@ typedef struct proof proof;
 struct clause;
 struct file;
 
-void kissat_init_proof (struct kissat *, struct file *, bool binary);
+void kissat_init_proof (struct kissat *, struct file *,
+		bool binary, bool frat);
 void kissat_release_proof (struct kissat *);
 
 #ifndef QUIET
@@ -22,8 +23,12 @@ void kissat_add_binary_to_proof (struct kissat *, unsigned, unsigned);
 void kissat_add_clause_to_proof (struct kissat *, const struct clause *c);
 void kissat_add_empty_to_proof (struct kissat *);
 void kissat_add_lits_to_proof (struct kissat *, size_t, const unsigned *);
+void kissat_add_original_to_proof (struct kissat *, size_t, const int *);
 void kissat_add_unit_to_proof (struct kissat *, unsigned);
 
+void kissat_add_learned_hints_to_proof (struct kissat *,
+					const struct clause *conflict);
+
 void kissat_shrink_clause_in_proof (struct kissat *, const struct clause *,
 				    unsigned remove, unsigned keep);
 
@@ -58,6 +63,18 @@ do { \
     kissat_add_lits_to_proof (solver, (SIZE), (LITS)); \
 } while (0)
 
+#define ADD_ORIGINAL_TO_PROOF(SIZE,LITS) \
+do { \
+  if (solver->proof) \
+    kissat_add_original_to_proof (solver, (SIZE), (LITS)); \
+} while (0)
+
+#define ADD_LEARNED_HINTS_TO_PROOF(CONFLICT) \
+do { \
+  if (solver->proof) \
+    kissat_add_learned_hints_to_proof (solver, (CONFLICT)); \
+} while (0)
+
 #define ADD_STACK_TO_PROOF(S) \
   ADD_LITS_TO_PROOF (SIZE_STACK (S), BEGIN_STACK (S))
 
@@ -104,6 +121,8 @@ do { \
 #define ADD_CLAUSE_TO_PROOF(...) do { } while (0)
 #define ADD_LITS_TO_PROOF(...) do { } while (0)
 #define ADD_EMPTY_TO_PROOF(...) do { } while (0)
+#define ADD_LEARNED_HINTS_TO_PROOF(...) do { } while (0)
+#define ADD_ORIGINAL_TO_PROOF(...) do { } while (0)
 #define ADD_STACK_TO_PROOF(...) do { } while (0)
 #define ADD_UNIT_TO_PROOF(...) do { } while (0)
 
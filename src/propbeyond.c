@@ -12,8 +12,13 @@ static void
 propagate_literals_beyond_conflicts (kissat * solver)
 {
   unsigned *propagate = solver->propagate;
+  unsigned *binary = propagate;
   while (propagate != END_ARRAY (solver->trail))
-    (void) propagate_literal_beyond_conflicts (solver, *propagate++);
+    {
+      while (binary != END_ARRAY (solver->trail))
+	(void) kissat_propagate_binary_watches (solver, *binary++);
+      (void) propagate_literal_beyond_conflicts (solver, *propagate++);
+    }
   solver->propagate = propagate;
 }
 
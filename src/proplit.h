@@ -17,6 +17,16 @@ kissat_watch_large_delayed (kissat * solver,
       assert (d != end_delayed);
       const reference ref = *d++;
       const unsigned blocking = watch.blocking.lit;
+      if (watch.type.ternary)
+	{
+	  assert (d != end_delayed);
+	  const unsigned second = *d++;
+	  LOGREF (ref, "watching %s ternary %s %s in", LOGLIT (lit),
+		  LOGLIT (blocking), LOGLIT (second));
+	  kissat_push_ternary_watch (solver, lit_watches,
+				     blocking, second, ref);
+	  continue;
+	}
       LOGREF (ref, "watching %s blocking %s in", LOGLIT (lit),
 	      LOGLIT (blocking));
       kissat_push_blocking_watch (solver, lit_watches, blocking, ref);
@@ -86,6 +96,61 @@ kissat_update_search_propagation_statistics (kissat * solver,
 
 #endif
 
+#ifndef NPREFETCH
+
+// Clauses are prefetched ahead of visiting their large watches.  First the
+// value of the blocking literal of the watch 'PREFETCH_VALUE_DISTANCE'
+// watches ahead is prefetched.  Later, when that watch is only
+// 'PREFETCH_CLAUSE_DISTANCE' watches ahead, the (now cached) blocking
+// literal value is checked and, unless the literal is true, the clause is
+// prefetched too.  Since ternary watches are longer than watch pairs,
+// these two watches are tracked by the cursors 'value_ahead' and
+// 'clause_ahead'.  For ternary watches the values of both inlined literals
+// are checked and the clause is only prefetched if neither is true.
+
+#define PREFETCH_VALUE_DISTANCE 8
+#define PREFETCH_CLAUSE_DISTANCE 4
+
+static inline const watch *
+kissat_skip_large_watches (const watch * p, const watch * end_watches,
+			   unsigned watches)
+{
+  while (watches-- && p != end_watches)
+    p += 2 + p->type.ternary;
+  return p;
+}
+
+static inline bool
+kissat_prefetch_large_watch (const value * values, ward * arena,
+			     const watch ** value_ahead,
+			     const watch ** clause_ahead,
+			     const watch * end_watches)
+{
+  const watch *p = *value_ahead;
+  if (p != end_watches)
+    {
+      const watch head = *p;
+      __builtin_prefetch (values + head.blocking.lit, 0, 1);
+      if (head.type.ternary)
+	__builtin_prefetch (values + p[2].blocking.lit, 0, 1);
+      *value_ahead = p + 2 + head.type.ternary;
+    }
+  p = *clause_ahead;
+  if (p == end_watches)
+    return false;
+  const watch head = *p;
+  *clause_ahead = p + 2 + head.type.ternary;
+  if (values[head.blocking.lit] > 0)
+    return false;
+  if (head.type.ternary && values[p[2].blocking.lit] > 0)
+    return false;
+  const watch tail = p[1];
+  __builtin_prefetch (arena + tail.raw, 0, 1);
+  return true;
+}
+
+#endif
+
 static inline void
 kissat_delay_watching_large (kissat * solver, unsigneds * const delayed,
 			     unsigned lit, unsigned other, reference ref)
@@ -96,6 +161,80 @@ kissat_delay_watching_large (kissat * solver, unsigneds * const delayed,
   PUSH_STACK (*delayed, ref);
 }
 
+static inline void
+kissat_delay_watching_ternary (kissat * solver, unsigneds * const delayed,
+			       unsigned lit, unsigned first, unsigned second,
+			       reference ref)
+{
+  const watch watch = kissat_ternary_watch (first);
+  PUSH_STACK (*delayed, lit);
+  PUSH_STACK (*delayed, watch.raw);
+  PUSH_STACK (*delayed, ref);
+  PUSH_STACK (*delayed, second);
+}
+
+// Binary watches precede large watches (see 'watch.h').  Binary clauses
+// are propagated for all literals on the trail first, before the large
+// watches of the next literal are visited by 'PROPAGATE_LITERAL', which
+// then only has to skip over the binary watches.
+
+static inline clause *
+kissat_propagate_binary_watches (kissat * solver, const unsigned lit)
+{
+  assert (solver->watching);
+  LOG (PROPAGATION_TYPE " propagating binary clauses of %s", LOGLIT (lit));
+  assert (VALUE (lit) > 0);
+
+  assigned *const assigned = solver->assigned;
+  value *const values = solver->values;
+
+  const unsigned not_lit = NOT (lit);
+
+  assert (not_lit < LITS);
+  watches *watches = solver->watches + not_lit;
+
+  const watch *const begin_watches = BEGIN_WATCHES (*watches);
+  const watch *const end_watches = END_WATCHES (*watches);
+  const watch *p = begin_watches;
+
+  const unsigned idx = IDX (lit);
+  const unsigned level = assigned[idx].level;
+  const bool probing = solver->probing;
+  uint64_t ticks = 1;
+  clause *res = 0;
+
+  while (p != end_watches)
+    {
+      const watch watch = *p;
+      if (!watch.type.binary)
+	break;
+      p++;
+      const unsigned other = watch.binary.lit;
+      assert (VALID_INTERNAL_LITERAL (other));
+      const value other_value = values[other];
+      if (other_value > 0)
+	continue;
+      const bool redundant = watch.binary.redundant;
+      if (other_value < 0)
+	{
+	  res = kissat_binary_conflict (solver, redundant, not_lit, other);
+#ifndef CONTINUE_PROPAGATING_AFTER_CONFLICT
+	  break;
+#endif
+	}
+      else
+	{
+	  kissat_fast_binary_assign (solver, probing, level, values,
+				     assigned, redundant, other, not_lit);
+	  ticks++;
+	}
+    }
+  ticks += kissat_cache_lines (p - begin_watches, sizeof (watch));
+  solver->ticks += ticks;
+
+  return res;
+}
+
 static inline clause *
 PROPAGATE_LITERAL (kissat * solver,
 #if defined(PROBING_PROPAGATION)
@@ -104,7 +243,7 @@ PROPAGATE_LITERAL (kissat * solver,
 		   const unsigned lit)
 {
   assert (solver->watching);
-  LOG (PROPAGATION_TYPE " propagating %s", LOGLIT (lit));
+  LOG (PROPAGATION_TYPE " propagating large clauses of %s", LOGLIT (lit));
   assert (VALUE (lit) > 0);
   assert (EMPTY_STACK (solver->delayed));
 
@@ -122,53 +261,48 @@ PROPAGATE_LITERAL (kissat * solver,
   const watch *const end_watches = END_WATCHES (*watches);
 
   watch *q = begin_watches;
+  while (q != end_watches && q->type.binary)
+    q++;
   const watch *p = q;
 
   unsigneds *const delayed = &solver->delayed;
   assert (EMPTY_STACK (*delayed));
 
-  const size_t size_watches = SIZE_WATCHES (*watches);
+  const size_t size_watches = end_watches - p;
   uint64_t ticks = 1 + kissat_cache_lines (size_watches, sizeof (watch));
-  const unsigned idx = IDX (lit);
-  struct assigned *const a = assigned + idx;
-  const bool probing = solver->probing;
-  const unsigned level = a->level;
+  uint64_t prefetched = 0, visited = 0;
+  const unsigned simd = GET_OPTION (simd) ? solver->simd : SIMD_SCALAR;
   clause *res = 0;
 
+#ifndef NPREFETCH
+  const watch *value_ahead =
+    kissat_skip_large_watches (p, end_watches, PREFETCH_VALUE_DISTANCE);
+  const watch *clause_ahead =
+    kissat_skip_large_watches (p, end_watches, PREFETCH_CLAUSE_DISTANCE);
+#endif
+
   while (p != end_watches)
     {
+#ifndef NPREFETCH
+      prefetched += kissat_prefetch_large_watch (values, arena, &value_ahead,
+						 &clause_ahead, end_watches);
+#endif
       const watch head = *q++ = *p++;
+      assert (!head.type.binary);
       const unsigned blocking = head.blocking.lit;
       assert (VALID_INTERNAL_LITERAL (blocking));
       const value blocking_value = values[blocking];
-      const bool binary = head.type.binary;
-      watch tail;
-      if (!binary)
-	tail = *q++ = *p++;
-      if (blocking_value > 0)
-	continue;
-      if (binary)
-	{
-	  const bool redundant = head.binary.redundant;
-	  if (blocking_value < 0)
-	    {
-	      res = kissat_binary_conflict (solver, redundant,
-					    not_lit, blocking);
-#ifndef CONTINUE_PROPAGATING_AFTER_CONFLICT
-	      break;
-#endif
-	    }
-	  else
-	    {
-	      assert (!blocking_value);
-	      kissat_fast_binary_assign (solver, probing, level,
-					 values, assigned,
-					 redundant, blocking, not_lit);
-	      ticks++;
-	    }
-	}
-      else
+      const watch tail = *q++ = *p++;
+      if (head.type.ternary)
 	{
+	  const watch third = *q++ = *p++;
+	  if (blocking_value > 0)
+	    continue;
+	  const unsigned second = third.blocking.lit;
+	  assert (VALID_INTERNAL_LITERAL (second));
+	  const value second_value = values[second];
+	  if (second_value > 0)
+	    continue;
 	  const reference ref = tail.raw;
 	  assert (ref < SIZE_STACK (solver->arena));
 	  clause *const c = (clause *) (arena + ref);
@@ -177,68 +311,15 @@ PROPAGATE_LITERAL (kissat * solver,
 	    continue;
 #endif
 	  ticks++;
+	  visited++;
+	  assert (c->size == 3);
 	  if (c->garbage)
 	    {
-	      q -= 2;
-	      continue;
-	    }
-	  unsigned *const lits = BEGIN_LITS (c);
-	  const unsigned other = lits[0] ^ lits[1] ^ not_lit;
-	  assert (lits[0] != lits[1]);
-	  assert (VALID_INTERNAL_LITERAL (other));
-	  assert (not_lit != other);
-	  assert (lit != other);
-	  const value other_value = values[other];
-	  if (other_value > 0)
-	    {
-	      q[-2].blocking.lit = other;
+	      q -= 3;
 	      continue;
 	    }
-	  const unsigned *const end_lits = lits + c->size;
-	  unsigned *const searched = lits + c->searched;
-	  assert (c->lits + 2 <= searched);
-	  assert (searched < end_lits);
-	  unsigned *r, replacement = INVALID_LIT;
-	  value replacement_value = -1;
-	  for (r = searched; r != end_lits; r++)
-	    {
-	      replacement = *r;
-	      assert (VALID_INTERNAL_LITERAL (replacement));
-	      replacement_value = values[replacement];
-	      if (replacement_value >= 0)
-		break;
-	    }
-	  if (replacement_value < 0)
-	    {
-	      for (r = lits + 2; r != searched; r++)
-		{
-		  replacement = *r;
-		  assert (VALID_INTERNAL_LITERAL (replacement));
-		  replacement_value = values[replacement];
-		  if (replacement_value >= 0)
-		    break;
-		}
-	    }
-
-	  if (replacement_value >= 0)
-	    {
-	      c->searched = r - lits;
-	      assert (replacement != INVALID_LIT);
-	      LOGREF (ref, "unwatching %s in", LOGLIT (not_lit));
-	      q -= 2;
-	      lits[0] = other;
-	      lits[1] = replacement;
-	      assert (lits[0] != lits[1]);
-	      *r = not_lit;
-	      kissat_delay_watching_large (solver, delayed,
-					   replacement, other, ref);
-	      ticks++;
-	    }
-	  else if (other_value)
+	  if (blocking_value < 0 && second_value < 0)
 	    {
-	      assert (replacement_value < 0);
-	      assert (blocking_value < 0);
-	      assert (other_value < 0);
 	      LOGREF (ref, "conflicting");
 	      res = c;
 #ifndef CONTINUE_PROPAGATING_AFTER_CONFLICT
@@ -247,14 +328,130 @@ PROPAGATE_LITERAL (kissat * solver,
 	    }
 	  else
 	    {
-	      assert (replacement_value < 0);
-	      kissat_fast_assign_reference (solver, values,
-					    assigned, other, ref, c);
+	      unsigned *const lits = BEGIN_LITS (c);
+	      const unsigned other = lits[0] ^ lits[1] ^ not_lit;
+	      const unsigned replacement = lits[2];
+	      assert (other == blocking || other == second);
+	      assert (replacement == blocking || replacement == second);
+	      const value replacement_value =
+		replacement == blocking ? blocking_value : second_value;
+	      if (replacement_value < 0)
+		{
+		  assert (!values[other]);
+		  kissat_fast_assign_reference (solver, values,
+						assigned, other, ref, c);
+		}
+	      else
+		{
+		  // Move the watch to the unwatched literal even if the
+		  // other watched literal is false (but still pending on the
+		  // trail) and the clause thus unit, as for large clauses.
+		  // Otherwise the propagated literal is not watched and
+		  // chronological backtracking might leave a false watched
+		  // literal in an unsatisfied clause.
+		  LOGREF (ref, "unwatching %s in", LOGLIT (not_lit));
+		  q -= 3;
+		  lits[0] = other;
+		  lits[1] = replacement;
+		  lits[2] = not_lit;
+		  kissat_delay_watching_ternary (solver, delayed, replacement,
+						 other, not_lit, ref);
+		  if (values[other] < 0)
+		    kissat_fast_assign_reference (solver, values, assigned,
+						  replacement, ref, c);
+		}
 	      ticks++;
 	    }
+	  continue;
+	}
+      if (blocking_value > 0)
+	continue;
+      const reference ref = tail.raw;
+      assert (ref < SIZE_STACK (solver->arena));
+      clause *const c = (clause *) (arena + ref);
+#if defined(PROBING_PROPAGATION)
+      if (c == ignore)
+	continue;
+#endif
+      ticks++;
+      visited++;
+      assert (c->size > 3 || !GET_OPTION (ternary));
+      if (c->garbage)
+	{
+	  q -= 2;
+	  continue;
+	}
+      unsigned *const lits = BEGIN_LITS (c);
+      const unsigned other = lits[0] ^ lits[1] ^ not_lit;
+      assert (lits[0] != lits[1]);
+      assert (VALID_INTERNAL_LITERAL (other));
+      assert (not_lit != other);
+      assert (lit != other);
+      const value other_value = values[other];
+      if (other_value > 0)
+	{
+	  q[-2].blocking.lit = other;
+	  continue;
+	}
+      const unsigned *const end_lits = lits + c->size;
+      unsigned *const searched = lits + c->searched;
+      assert (c->lits + 2 <= searched);
+      assert (searched < end_lits);
+      unsigned *r = kissat_search_non_false (simd, values, LITS,
+					     searched, end_lits);
+      bool found = (r != end_lits);
+      if (!found)
+	{
+	  r = kissat_search_non_false (simd, values, LITS, lits + 2,
+				       searched);
+	  found = (r != searched);
+	}
+      unsigned replacement = INVALID_LIT;
+      value replacement_value = -1;
+      if (found)
+	{
+	  replacement = *r;
+	  assert (VALID_INTERNAL_LITERAL (replacement));
+	  replacement_value = values[replacement];
+	  assert (replacement_value >= 0);
+	}
+
+      if (replacement_value >= 0)
+	{
+	  c->searched = r - lits;
+	  assert (replacement != INVALID_LIT);
+	  LOGREF (ref, "unwatching %s in", LOGLIT (not_lit));
+	  q -= 2;
+	  lits[0] = other;
+	  lits[1] = replacement;
+	  assert (lits[0] != lits[1]);
+	  *r = not_lit;
+	  kissat_delay_watching_large (solver, delayed,
+				       replacement, other, ref);
+	  ticks++;
+	}
+      else if (other_value)
+	{
+	  assert (replacement_value < 0);
+	  assert (blocking_value < 0);
+	  assert (other_value < 0);
+	  LOGREF (ref, "conflicting");
+	  res = c;
+#ifndef CONTINUE_PROPAGATING_AFTER_CONFLICT
+	  break;
+#endif
+	}
+      else
+	{
+	  assert (replacement_value < 0);
+	  kissat_fast_assign_reference (solver, values,
+					assigned, other, ref, c);
+	  ticks++;
 	}
     }
   solver->ticks += ticks;
+  ADD (clauses_prefetched, prefetched);
+  ADD (clauses_visited, visited);
 
   while (p != end_watches)
     *q++ = *p++;
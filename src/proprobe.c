@@ -19,9 +19,14 @@ kissat_probing_propagate (kissat * solver, clause * ignore, bool flush)
 
   clause *conflict = 0;
   unsigned *propagate = solver->propagate;
+  unsigned *binary = propagate;
   solver->ticks = 0;
   while (!conflict && propagate != END_ARRAY (solver->trail))
     {
+      while (!conflict && binary != END_ARRAY (solver->trail))
+	conflict = kissat_propagate_binary_watches (solver, *binary++);
+      if (conflict)
+	break;
       const unsigned lit = *propagate++;
       conflict = probing_propagate_literal (solver, ignore, lit);
     }
@@ -41,8 +41,14 @@ search_propagate (kissat * solver)
 {
   clause *res = 0;
   unsigned *propagate = solver->propagate;
+  unsigned *binary = propagate;
   while (!res && propagate != END_ARRAY (solver->trail))
-    res = search_propagate_literal (solver, *propagate++);
+    {
+      while (!res && binary != END_ARRAY (solver->trail))
+	res = kissat_propagate_binary_watches (solver, *binary++);
+      if (!res)
+	res = search_propagate_literal (solver, *propagate++);
+    }
   solver->propagate = propagate;
   return res;
 }
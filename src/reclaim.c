@@ -0,0 +1,128 @@
+#include "arena.h"
+#include "collect.h"
+#include "internal.h"
+#include "kitten.h"
+#include "logging.h"
+#include "print.h"
+#include "reclaim.h"
+#include "reduce.h"
+
+#include <inttypes.h>
+
+// The memory limit is enforced at the same safe points in the search loop
+// as the other limits.  As soon as the allocated memory exceeds the
+// reclaim limit ('memreclaim' percent of the memory limit) we first try to
+// free memory and only if this does not bring the allocated memory below
+// the memory limit the search returns without result.  Reclaiming again
+// within less than 'reduceint' conflicts would only thrash.  Then we wait
+// until the memory limit itself is hit, which ends the search.
+
+size_t
+kissat_allocated (kissat * solver)
+{
+  return solver->allocated + kissat_mapped_arena_bytes (solver);
+}
+
+bool
+kissat_reclaiming (kissat * solver)
+{
+  if (!solver->limited.memory)
+    return false;
+  return kissat_allocated (solver) > solver->limits.reclaim.bytes;
+}
+
+#define RELEASE_UNUSED_STACK(S) \
+do { \
+  if (EMPTY_STACK (S)) \
+    RELEASE_STACK (S); \
+} while (0)
+
+static void
+release_buffers (kissat * solver)
+{
+  if (solver->kitten)
+    {
+      kitten_release (solver->kitten);
+      solver->kitten = 0;
+    }
+
+  RELEASE_STACK (solver->sweep);
+
+  RELEASE_UNUSED_STACK (solver->analyzed);
+  RELEASE_UNUSED_STACK (solver->clause);
+  RELEASE_UNUSED_STACK (solver->delayed);
+  RELEASE_UNUSED_STACK (solver->levels);
+  RELEASE_UNUSED_STACK (solver->minimize);
+  RELEASE_UNUSED_STACK (solver->poisoned);
+  RELEASE_UNUSED_STACK (solver->promote);
+  RELEASE_UNUSED_STACK (solver->ranks);
+  RELEASE_UNUSED_STACK (solver->removable);
+  RELEASE_UNUSED_STACK (solver->resolvents);
+  RELEASE_UNUSED_STACK (solver->shadow);
+  RELEASE_UNUSED_STACK (solver->shrinkable);
+  RELEASE_UNUSED_STACK (solver->sorter);
+
+  for (unsigned i = 0; i < 2; i++)
+    {
+      RELEASE_UNUSED_STACK (solver->antecedents[i]);
+      RELEASE_UNUSED_STACK (solver->gates[i]);
+      RELEASE_UNUSED_STACK (solver->xorted[i]);
+    }
+}
+
+static void
+update_reclaim_limits (kissat * solver, size_t allocated)
+{
+  limits *limits = &solver->limits;
+  const uint64_t memory = limits->memory;
+  uint64_t bytes = memory / 100 * GET_OPTION (memreclaim);
+  if (allocated < memory)
+    {
+      const uint64_t delta = (memory - allocated) / 2;
+      if (bytes < allocated + delta)
+	bytes = allocated + delta;
+    }
+  limits->reclaim.bytes = bytes;
+  limits->reclaim.conflicts = CONFLICTS + GET_OPTION (reduceint);
+  LOG ("new reclaim limit %" PRIu64 " bytes after %" PRIu64 " conflicts",
+       limits->reclaim.bytes, limits->reclaim.conflicts);
+}
+
+int
+kissat_reclaim (kissat * solver)
+{
+  assert (solver->limited.memory);
+  limits *limits = &solver->limits;
+#ifndef QUIET
+  const size_t before = kissat_allocated (solver);
+#endif
+  if (CONFLICTS < limits->reclaim.conflicts)
+    {
+      if (limits->reclaim.bytes < limits->memory)
+	{
+	  kissat_very_verbose (solver, "postponing reclaiming memory "
+			       "until memory limit %" PRIu64 " is hit",
+			       limits->memory);
+	  limits->reclaim.bytes = limits->memory;
+	}
+      return 0;
+    }
+  INC (reclaims);
+  kissat_phase (solver, "reclaim", GET (reclaims),
+		"allocated %s exceeds reclaim limit %s",
+		FORMAT_BYTES (before), FORMAT_BYTES (limits->reclaim.bytes));
+  int res = kissat_reduce_all (solver);
+  if (!res)
+    {
+      kissat_shrink_arena (solver);
+      kissat_defrag_watches (solver);
+      release_buffers (solver);
+    }
+  const size_t after = kissat_allocated (solver);
+  kissat_phase (solver, "reclaim", GET (reclaims),
+		"reclaimed %s leaving %s allocated",
+		FORMAT_BYTES (before > after ? before - after : 0),
+		FORMAT_BYTES (after));
+  update_reclaim_limits (solver, after);
+  return res;
+}
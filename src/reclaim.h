@@ -0,0 +1,13 @@
+#ifndef _reclaim_h_INCLUDED
+#define _reclaim_h_INCLUDED
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+struct kissat;
+
+size_t kissat_allocated (struct kissat *);
+bool kissat_reclaiming (struct kissat *);
+int kissat_reclaim (struct kissat *);
+
+#endif
@@ -47,7 +47,7 @@ collect_reducibles (kissat * solver, reducibles * reds, reference start_ref)
   const clause *const end = (clause *) END_STACK (solver->arena);
   assert (start < end);
   while (start != end && (!start->redundant || start->keep))
-    start = kissat_next_clause (start);
+    start = kissat_next_clause (solver, start);
   if (start == end)
     {
       solver->first_reducible = INVALID_REF;
@@ -65,7 +65,7 @@ collect_reducibles (kissat * solver, reducibles * reds, reference start_ref)
 #endif
   solver->first_reducible = redundant;
   const unsigned tier2 = GET_OPTION (tier2);
-  for (clause * c = start; c != end; c = kissat_next_clause (c))
+  for (clause * c = start; c != end; c = kissat_next_clause (solver, c))
     {
       if (!c->redundant)
 	continue;
@@ -75,17 +75,18 @@ collect_reducibles (kissat * solver, reducibles * reds, reference start_ref)
 	continue;
       if (c->keep)
 	continue;
-      if (c->used)
+      cold *const cold = COLD (c);
+      if (cold->used)
 	{
-	  c->used--;
-	  if (c->glue <= tier2)
+	  cold->used--;
+	  if (cold->glue <= tier2)
 	    continue;
 	}
       assert (!c->garbage);
       assert (kissat_clause_in_arena (solver, c));
       reducible red;
-      const uint64_t negative_size = ~c->size;
-      const uint64_t negative_glue = ~c->glue;
+      const uint64_t negative_size = ~(unsigned) c->size;
+      const uint64_t negative_glue = ~cold->glue;
       red.rank = negative_size | (negative_glue << 32);
       red.ref = (ward *) c - arena;
       PUSH_STACK (*reds, red);
@@ -107,10 +108,11 @@ sort_reducibles (kissat * solver, reducibles * reds)
 }
 
 static void
-mark_less_useful_clauses_as_garbage (kissat * solver, reducibles * reds)
+mark_less_useful_clauses_as_garbage (kissat * solver,
+				     reducibles * reds, unsigned fraction)
 {
   const size_t size = SIZE_STACK (*reds);
-  size_t target = size * (GET_OPTION (reducefraction) / 100.0);
+  size_t target = size * (fraction / 100.0);
 #ifndef QUIET
   statistics *statistics = &solver->statistics;
   const size_t clauses =
@@ -155,14 +157,9 @@ compacting (kissat * solver)
   return compact;
 }
 
-int
-kissat_reduce (kissat * solver)
+static void
+reduce_clauses (kissat * solver, unsigned fraction)
 {
-  START (reduce);
-  INC (reductions);
-  kissat_phase (solver, "reduce", GET (reductions),
-		"reduce limit %" PRIu64 " hit after %" PRIu64
-		" conflicts", solver->limits.reduce.conflicts, CONFLICTS);
   bool compact = compacting (solver);
   reference start = compact ? 0 : solver->first_reducible;
   if (start != INVALID_REF)
@@ -186,7 +183,7 @@ kissat_reduce (kissat * solver)
 	  if (collect_reducibles (solver, &reds, start))
 	    {
 	      sort_reducibles (solver, &reds);
-	      mark_less_useful_clauses_as_garbage (solver, &reds);
+	      mark_less_useful_clauses_as_garbage (solver, &reds, fraction);
 	      RELEASE_STACK (reds);
 	      kissat_sparse_collect (solver, compact, start);
 	    }
@@ -200,8 +197,36 @@ kissat_reduce (kissat * solver)
     }
   else
     kissat_phase (solver, "reduce", GET (reductions), "nothing to reduce");
+}
+
+int
+kissat_reduce (kissat * solver)
+{
+  START (reduce);
+  INC (reductions);
+  kissat_phase (solver, "reduce", GET (reductions),
+		"reduce limit %" PRIu64 " hit after %" PRIu64
+		" conflicts", solver->limits.reduce.conflicts, CONFLICTS);
+  reduce_clauses (solver, GET_OPTION (reducefraction));
   UPDATE_CONFLICT_LIMIT (reduce, reductions, SQRT, false);
   REPORT (0, '-');
   STOP (reduce);
   return solver->inconsistent ? 20 : 0;
 }
+
+// Emergency reduction used to reclaim memory.  It removes all reducible
+// clauses, not only the configured fraction, and leaves the reduction
+// schedule untouched.
+
+int
+kissat_reduce_all (kissat * solver)
+{
+  START (reduce);
+  kissat_phase (solver, "reduce", GET (reductions),
+		"emergency reduction after %" PRIu64 " conflicts",
+		CONFLICTS);
+  reduce_clauses (solver, 100);
+  REPORT (0, '-');
+  STOP (reduce);
+  return solver->inconsistent ? 20 : 0;
+}
@@ -49,6 +49,38 @@ reallocate_trail (kissat * solver, unsigned old_size, unsigned new_size)
   solver->propagate = BEGIN_ARRAY (solver->trail) + propagated;
 }
 
+static void
+increase_variables (kissat * solver, unsigned old_size, unsigned new_size)
+{
+  CREALLOC_VARIABLE_INDEXED (assigned, assigned);
+  CREALLOC_VARIABLE_INDEXED (flags, flags);
+  CREALLOC_VARIABLE_INDEXED (bool, frozen);
+  NREALLOC_VARIABLE_INDEXED (links, links);
+
+  CREALLOC_LITERAL_INDEXED (mark, marks);
+  CREALLOC_LITERAL_INDEXED (value, values);
+  CREALLOC_LITERAL_INDEXED (watches, watches);
+
+  reallocate_trail (solver, old_size, new_size);
+  kissat_increase_phases (solver, new_size);
+}
+
+static void
+decrease_variables (kissat * solver, unsigned old_size, unsigned new_size)
+{
+  NREALLOC_VARIABLE_INDEXED (assigned, assigned);
+  NREALLOC_VARIABLE_INDEXED (flags, flags);
+  NREALLOC_VARIABLE_INDEXED (bool, frozen);
+  NREALLOC_VARIABLE_INDEXED (links, links);
+
+  NREALLOC_LITERAL_INDEXED (mark, marks);
+  NREALLOC_LITERAL_INDEXED (value, values);
+  NREALLOC_LITERAL_INDEXED (watches, watches);
+
+  reallocate_trail (solver, old_size, new_size);
+  kissat_decrease_phases (solver, new_size);
+}
+
 void
 kissat_increase_size (kissat * solver, unsigned new_size)
 {
@@ -61,17 +93,8 @@ kissat_increase_size (kissat * solver, unsigned new_size)
   LOG ("%s before increasing size from %u to %u",
        FORMAT_BYTES (kissat_allocated (solver)), old_size, new_size);
 #endif
-  CREALLOC_VARIABLE_INDEXED (assigned, assigned);
-  CREALLOC_VARIABLE_INDEXED (flags, flags);
-  NREALLOC_VARIABLE_INDEXED (links, links);
-
-  CREALLOC_LITERAL_INDEXED (mark, marks);
-  CREALLOC_LITERAL_INDEXED (value, values);
-  CREALLOC_LITERAL_INDEXED (watches, watches);
-
-  reallocate_trail (solver, old_size, new_size);
+  ACCOUNT (variables, increase_variables (solver, old_size, new_size));
   kissat_resize_heap (solver, SCORES, new_size);
-  kissat_increase_phases (solver, new_size);
 
   solver->size = new_size;
 
@@ -92,17 +115,8 @@ kissat_decrease_size (kissat * solver)
        FORMAT_BYTES (kissat_allocated (solver)), old_size, new_size);
 #endif
 
-  NREALLOC_VARIABLE_INDEXED (assigned, assigned);
-  NREALLOC_VARIABLE_INDEXED (flags, flags);
-  NREALLOC_VARIABLE_INDEXED (links, links);
-
-  NREALLOC_LITERAL_INDEXED (mark, marks);
-  NREALLOC_LITERAL_INDEXED (value, values);
-  NREALLOC_LITERAL_INDEXED (watches, watches);
-
-  reallocate_trail (solver, old_size, new_size);
+  ACCOUNT (variables, decrease_variables (solver, old_size, new_size));
   kissat_resize_heap (solver, SCORES, new_size);
-  kissat_decrease_phases (solver, new_size);
 
   solver->size = new_size;
 
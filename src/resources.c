@@ -59,6 +59,25 @@ kissat_current_resident_set_size (void)
   return scanned == 2 ? rss * sysconf (_SC_PAGESIZE) : 0;
 }
 
+#ifndef NHUGEPAGES
+
+uint64_t
+kissat_huge_pages_size (void)
+{
+  FILE *file = fopen ("/proc/self/smaps_rollup", "r");
+  if (!file)
+    return 0;
+  char line[128];
+  uint64_t res = 0;
+  while (fgets (line, sizeof line, file))
+    if (sscanf (line, "AnonHugePages: %" PRIu64 " kB", &res) == 1)
+      break;
+  fclose (file);
+  return res << 10;
+}
+
+#endif
+
 void
 kissat_print_resources (kissat * solver)
 {
@@ -72,6 +91,31 @@ kissat_print_resources (kissat * solver)
 	  "MB\n",
 	  "maximum-resident-set-size:",
 	  rss, "bytes", rss / (double) (1 << 20));
+#ifndef NHUGEPAGES
+  uint64_t huge = kissat_huge_pages_size ();
+  printf ("c "
+	  "%-" SFW1 "s "
+	  "%" SFW2 PRIu64 " "
+	  "%-" SFW3 "s "
+	  "%" SFW4 ".0f "
+	  "%%\n",
+	  "huge-pages:",
+	  huge, "bytes",
+	  kissat_percent (huge, kissat_current_resident_set_size ()));
+#endif
+  const memory *memory = &solver->memory;
+#define MEM(NAME) \
+  if (memory->peak[MEM_ ## NAME]) \
+    printf ("c " \
+	    "%-" SFW1 "s " \
+	    "%" SFW2 "zu " \
+	    "%-" SFW3 "s " \
+	    "%" SFW4 ".0f " \
+	    "MB\n", \
+	    #NAME "-peak:", memory->peak[MEM_ ## NAME], "bytes", \
+	    memory->peak[MEM_ ## NAME] / (double) (1 << 20));
+  MEMS
+#undef MEM
 #ifdef METRICS
   statistics *statistics = &solver->statistics;
   uint64_t max_allocated = statistics->allocated_max + sizeof (kissat);
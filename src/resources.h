@@ -15,6 +15,9 @@ struct kissat;
 double kissat_process_time (void);
 uint64_t kissat_current_resident_set_size (void);
 uint64_t kissat_maximum_resident_set_size (void);
+#ifndef NHUGEPAGES
+uint64_t kissat_huge_pages_size (void);
+#endif
 void kissat_print_resources (struct kissat *);
 
 #endif
@@ -1,3 +1,4 @@
+#include "assume.h"
 #include "backtrack.h"
 #include "bump.h"
 #include "decide.h"
@@ -17,7 +18,7 @@ kissat_restarting (kissat * solver)
   assert (solver->unassigned);
   if (!GET_OPTION (restart))
     return false;
-  if (!solver->level)
+  if (solver->level <= SIZE_STACK (solver->assumptions))
     return false;
   if (CONFLICTS < solver->limits.restart.conflicts)
     return false;
@@ -58,7 +59,7 @@ kissat_restart (kissat * solver)
     INC (stable_restarts);
   else
     INC (focused_restarts);
-  unsigned level = 0;
+  unsigned level = kissat_assumption_levels (solver);
   kissat_extremely_verbose (solver,
 			    "restarting after %" PRIu64 " conflicts"
 			    " (limit %" PRIu64 ")", CONFLICTS,
@@ -0,0 +1,115 @@
+#include "allocate.h"
+#include "import.h"
+#include "inline.h"
+#include "restore.h"
+
+// Reactivating an eliminated external variable requires to add back all
+// the clauses on the extension stack whose witness is on that variable.
+// This needs the 'incremental' option (enabled by default but disabled by
+// the stand-alone solver) to be set during elimination, since otherwise
+// only one side of the removed clauses is saved.  The literals of restored
+// clauses which are eliminated as well have to be reactivated too, which
+// in turn restores more clauses until fix-point.
+// The restored clauses are saved as zero terminated external clauses on
+// the 'restored' stack and added as original clauses before solving.
+
+static bool
+eliminated_external_variable (kissat * solver, unsigned eidx)
+{
+  assert (eidx < SIZE_STACK (solver->import));
+  const import *const import = &PEEK_STACK (solver->import, eidx);
+  return import->imported && import->eliminated;
+}
+
+static void
+reactivate_variables (kissat * solver, unsigneds * reactivate, bool *tainted)
+{
+  int *export = BEGIN_STACK (solver->export);
+  const size_t size_export = SIZE_STACK (solver->export);
+  for (size_t iidx = 0; iidx < size_export; iidx++)
+    {
+      const int elit = export[iidx];
+      if (!elit)
+	continue;
+      const unsigned eidx = ABS (elit);
+      if (!tainted[eidx])
+	continue;
+      assert (FLAGS (iidx)->eliminated);
+      LOG2 ("removing stale export of eliminated internal variable %zu",
+	    iidx);
+      export[iidx] = 0;
+    }
+  for (all_stack (unsigned, eidx, *reactivate))
+    {
+      import *import = &PEEK_STACK (solver->import, eidx);
+      assert (import->imported);
+      assert (import->eliminated);
+      import->imported = false;
+      import->eliminated = false;
+      const unsigned ilit = kissat_import_literal (solver, (int) eidx);
+      kissat_activate_literal (solver, ilit);
+      LOG ("reactivated external variable %u as %s", eidx, LOGVAR (ilit));
+      INC (reactivated);
+    }
+}
+
+void
+kissat_restore_eliminated (kissat * solver, unsigned eidx)
+{
+  assert (!solver->level);
+  assert (eliminated_external_variable (solver, eidx));
+  const size_t size_import = SIZE_STACK (solver->import);
+  bool *tainted = kissat_calloc (solver, size_import, sizeof *tainted);
+  unsigneds reactivate;
+  INIT_STACK (reactivate);
+  LOG ("restoring eliminated external variable %u", eidx);
+  tainted[eidx] = true;
+  PUSH_STACK (reactivate, eidx);
+  ints *restored = &solver->restored;
+  bool changed;
+  do
+    {
+      changed = false;
+      extension *const begin = BEGIN_STACK (solver->extend);
+      const extension *const end = END_STACK (solver->extend);
+      extension *q = begin;
+      const extension *p = begin;
+      while (p != end)
+	{
+	  const extension *const witness = p;
+	  assert (witness->blocking);
+	  do
+	    p++;
+	  while (p != end && !p->blocking);
+	  const unsigned widx = ABS (witness->lit);
+	  if (!tainted[widx])
+	    {
+	      for (const extension * r = witness; r != p; r++)
+		*q++ = *r;
+	      continue;
+	    }
+	  for (const extension * r = witness; r != p; r++)
+	    {
+	      const int elit = r->lit;
+	      PUSH_STACK (*restored, elit);
+	      const unsigned idx = ABS (elit);
+	      if (tainted[idx])
+		continue;
+	      if (!eliminated_external_variable (solver, idx))
+		continue;
+	      LOG ("restored clause requires eliminated external variable %u",
+		   idx);
+	      tainted[idx] = true;
+	      PUSH_STACK (reactivate, idx);
+	      changed = true;
+	    }
+	  PUSH_STACK (*restored, 0);
+	  INC (restored);
+	}
+      SET_END_OF_STACK (solver->extend, q);
+    }
+  while (changed);
+  reactivate_variables (solver, &reactivate, tainted);
+  RELEASE_STACK (reactivate);
+  kissat_dealloc (solver, tainted, size_import, sizeof *tainted);
+}
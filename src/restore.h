@@ -0,0 +1,8 @@
+#ifndef _restore_h_INCLUDED
+#define _restore_h_INCLUDED
+
+struct kissat;
+
+void kissat_restore_eliminated (struct kissat *, unsigned eidx);
+
+#endif
@@ -1,5 +1,8 @@
 #include "analyze.h"
+#include "assume.h"
 #include "bump.h"
+#include "checkpoint.h"
+#include "collect.h"
 #include "decide.h"
 #include "eliminate.h"
 #include "internal.h"
@@ -7,11 +10,13 @@
 #include "print.h"
 #include "probe.h"
 #include "propsearch.h"
+#include "reclaim.h"
 #include "search.h"
 #include "reduce.h"
 #include "reluctant.h"
 #include "report.h"
 #include "restart.h"
+#include "share.h"
 #include "terminate.h"
 #include "trail.h"
 #include "walk.h"
@@ -26,26 +31,33 @@ start_search (kissat * solver)
 
   REPORT (0, '*');
 
-  bool stable = (GET_OPTION (stable) == 2);
+  if (GET (searches) == 1)
+    {
+      bool stable = (GET_OPTION (stable) == 2);
 
-  solver->stable = stable;
-  kissat_phase (solver, "search", GET (searches),
-		"initializing %s search after %" PRIu64 " conflicts",
-		(stable ? "stable" : "focus"), CONFLICTS);
+      solver->stable = stable;
+      kissat_phase (solver, "search", GET (searches),
+		    "initializing %s search after %" PRIu64 " conflicts",
+		    (stable ? "stable" : "focus"), CONFLICTS);
 
-  kissat_init_averages (solver, &AVERAGES);
+      kissat_init_averages (solver, &AVERAGES);
 
-  if (solver->stable)
-    {
-      kissat_init_reluctant (solver);
-      kissat_update_scores (solver);
-    }
+      if (solver->stable)
+	{
+	  kissat_init_reluctant (solver);
+	  kissat_update_scores (solver);
+	}
 
-  kissat_init_limits (solver);
+      kissat_init_limits (solver);
 
-  unsigned seed = GET_OPTION (seed);
-  solver->random = seed;
-  LOG ("initialized random number generator with seed %u", seed);
+      unsigned seed = GET_OPTION (seed);
+      solver->random = seed;
+      LOG ("initialized random number generator with seed %u", seed);
+    }
+  else
+    kissat_phase (solver, "search", GET (searches),
+		  "resuming %s search after %" PRIu64 " conflicts",
+		  (solver->stable ? "stable" : "focus"), CONFLICTS);
 
 #ifndef QUIET
   limits *limits = &solver->limits;
@@ -65,7 +77,7 @@ start_search (kissat * solver)
 			 "starting search with decisions limited to %" PRIu64
 			 " and conflicts limited to %" PRIu64,
 			 limits->decisions, limits->conflicts);
-  if (stable)
+  if (solver->stable)
     {
       START (stable);
       REPORT (0, '[');
@@ -105,7 +117,6 @@ stop_search (kissat * solver, int res)
     {
       REPORT (0, ']');
       STOP (stable);
-      solver->stable = false;
     }
   else
     {
@@ -157,6 +168,20 @@ decision_limit_hit (kissat * solver)
   return true;
 }
 
+static bool
+memory_limit_hit (kissat * solver)
+{
+  if (!solver->limited.memory)
+    return false;
+  const size_t allocated = kissat_allocated (solver);
+  if (allocated <= solver->limits.memory)
+    return false;
+  kissat_very_verbose (solver, "memory limit %" PRIu64
+		       " hit with %zu bytes allocated",
+		       solver->limits.memory, allocated);
+  return true;
+}
+
 int
 kissat_search (kissat * solver)
 {
@@ -169,12 +194,22 @@ kissat_search (kissat * solver)
 	res = kissat_analyze (solver, conflict);
       else if (solver->iterating)
 	iterate (solver);
+      else if (kissat_importing (solver))
+	res = kissat_import_shared (solver);
+      else if (kissat_assuming (solver))
+	res = kissat_decide_assumption (solver);
       else if (!solver->unassigned)
 	res = 10;
       else if (TERMINATED (search_terminated_1))
 	break;
       else if (conflict_limit_hit (solver))
 	break;
+      else if (kissat_reclaiming (solver))
+	{
+	  res = kissat_reclaim (solver);
+	  if (!res && memory_limit_hit (solver))
+	    break;
+	}
       else if (kissat_reducing (solver))
 	res = kissat_reduce (solver);
       else if (kissat_switching_search_mode (solver))
@@ -187,6 +222,10 @@ kissat_search (kissat * solver)
 	res = kissat_eliminate (solver);
       else if (kissat_probing (solver))
 	res = kissat_probe (solver);
+      else if (kissat_defragmenting (solver))
+	kissat_defrag_watches_step (solver);
+      else if (kissat_checkpointing (solver))
+	kissat_checkpoint_search (solver);
       else if (decision_limit_hit (solver))
 	break;
       else
@@ -0,0 +1,293 @@
+#include "allocate.h"
+#include "inline.h"
+#include "logging.h"
+#include "share.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+// Learned units, binary and low glue clauses are shared between the
+// workers of a portfolio through one fixed size ring buffer of slots.
+// Producers reserve a position with an atomic increment of 'head' and
+// then claim the corresponding slot by switching its 'stamp' from an even
+// (stable) to the odd value '2*position+1' before writing the clause and
+// finally publish it by setting the stamp to '2*position+2'.  Consumers
+// keep their own cursor and copy a slot only if its stamp matches the
+// expected published value both before and after copying.  Nobody ever
+// waits.  Instead clauses are dropped if a slot is still being written or
+// has already been overwritten (when a consumer lags behind by more than
+// the capacity of the ring).  Sharing is thus lossy by design.  Clauses
+// are imported on the root level only, i.e., after restarts and after
+// learning units (iterating), and at most once per conflict.
+
+#define LD_SHARED_SLOTS 16
+#define SHARED_SLOTS (1u << LD_SHARED_SLOTS)
+
+#define LD_SHARED_FILTER 14
+#define SHARED_FILTER (1u << LD_SHARED_FILTER)
+
+#define MAX_SHARED_SIZE 16
+
+typedef struct slot slot;
+
+struct slot
+{
+  uint64_t stamp;
+  unsigned producer;
+  unsigned glue;
+  unsigned size;
+  int lits[MAX_SHARED_SIZE];
+};
+
+struct exchange
+{
+  uint64_t head;
+  slot slots[SHARED_SLOTS];
+};
+
+// The 'filter' of each worker is a direct mapped hash table of the hash
+// signatures of recently exported and imported clauses and is used to
+// filter duplicates.  Hash collisions only lose clauses.
+
+struct sharing
+{
+  exchange *exchange;
+  unsigned id;
+  uint64_t cursor;
+  uint64_t imported;
+  uint64_t *filter;
+};
+
+exchange *
+kissat_new_exchange (kissat * solver)
+{
+  exchange *res = kissat_calloc (solver, 1, sizeof *res);
+  LOG ("allocated clause exchange with %u slots", SHARED_SLOTS);
+  return res;
+}
+
+void
+kissat_delete_exchange (kissat * solver, exchange * exchange)
+{
+  kissat_free (solver, exchange, sizeof *exchange);
+}
+
+void
+kissat_connect_sharing (kissat * solver, exchange * exchange, unsigned id)
+{
+  assert (!solver->sharing);
+  sharing *sharing = kissat_calloc (solver, 1, sizeof *sharing);
+  sharing->exchange = exchange;
+  sharing->id = id;
+  sharing->cursor = __atomic_load_n (&exchange->head, __ATOMIC_ACQUIRE);
+  CALLOC (sharing->filter, SHARED_FILTER);
+  solver->sharing = sharing;
+}
+
+void
+kissat_release_sharing (kissat * solver)
+{
+  sharing *sharing = solver->sharing;
+  if (!sharing)
+    return;
+  DEALLOC (sharing->filter, SHARED_FILTER);
+  kissat_free (solver, sharing, sizeof *sharing);
+  solver->sharing = 0;
+}
+
+static uint64_t
+hash_literal (int elit)
+{
+  uint64_t res = (unsigned) elit;
+  res *= 0x9e3779b97f4a7c15ull;
+  return res ^ (res >> 29);
+}
+
+static uint64_t
+hash_clause (unsigned size, const int *lits)
+{
+  uint64_t res = 0;
+  for (unsigned i = 0; i < size; i++)
+    res += hash_literal (lits[i]);
+  return res ? res : 1;
+}
+
+static bool
+duplicated (sharing * sharing, uint64_t hash)
+{
+  uint64_t *entry = sharing->filter + (hash >> (64 - LD_SHARED_FILTER));
+  if (*entry == hash)
+    return true;
+  *entry = hash;
+  return false;
+}
+
+void
+kissat_export_shared (kissat * solver, unsigned glue)
+{
+  sharing *sharing = solver->sharing;
+  assert (sharing);
+  const unsigned size = SIZE_STACK (solver->clause);
+  if (size > (unsigned) GET_OPTION (sharesize))
+    return;
+  if (size > 2 && glue > (unsigned) GET_OPTION (shareglue))
+    return;
+  assert (size <= MAX_SHARED_SIZE);
+  int lits[MAX_SHARED_SIZE];
+  const unsigned *const ilits = BEGIN_STACK (solver->clause);
+  for (unsigned i = 0; i < size; i++)
+    if (!(lits[i] = kissat_export_literal (solver, ilits[i])))
+      return;
+  if (duplicated (sharing, hash_clause (size, lits)))
+    return;
+  exchange *exchange = sharing->exchange;
+  const uint64_t position =
+    __atomic_fetch_add (&exchange->head, 1, __ATOMIC_RELAXED);
+  slot *slot = exchange->slots + (position & (SHARED_SLOTS - 1));
+  const uint64_t writing = 2 * position + 1;
+  uint64_t stamp = __atomic_load_n (&slot->stamp, __ATOMIC_RELAXED);
+  if ((stamp & 1) || stamp >= writing ||
+      !__atomic_compare_exchange_n (&slot->stamp, &stamp, writing, false,
+				    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      LOG ("dropping exported clause at busy position %" PRIu64, position);
+      return;
+    }
+  slot->producer = sharing->id;
+  slot->glue = glue;
+  slot->size = size;
+  memcpy (slot->lits, lits, size * sizeof *lits);
+  __atomic_store_n (&slot->stamp, writing + 1, __ATOMIC_RELEASE);
+  LOGTMP ("exported glue %u size %u", glue, size);
+  INC (shared_exported);
+}
+
+bool
+kissat_importing (kissat * solver)
+{
+  sharing *sharing = solver->sharing;
+  if (!sharing)
+    return false;
+  if (solver->level)
+    return false;
+  if (sharing->imported == CONFLICTS)
+    return false;
+  const exchange *exchange = sharing->exchange;
+  return sharing->cursor != __atomic_load_n (&exchange->head,
+					     __ATOMIC_RELAXED);
+}
+
+static bool
+read_slot (const exchange * exchange, uint64_t position, slot * copy)
+{
+  const slot *slot = exchange->slots + (position & (SHARED_SLOTS - 1));
+  const uint64_t published = 2 * position + 2;
+  if (__atomic_load_n (&slot->stamp, __ATOMIC_ACQUIRE) != published)
+    return false;
+  *copy = *slot;
+  __atomic_thread_fence (__ATOMIC_ACQUIRE);
+  if (__atomic_load_n (&slot->stamp, __ATOMIC_RELAXED) != published)
+    return false;
+  return copy->size <= MAX_SHARED_SIZE;
+}
+
+static int
+import_shared_clause (kissat * solver, const slot * slot)
+{
+  INC (shared_received);
+  const unsigned size = slot->size;
+  const int *const lits = slot->lits;
+  if (duplicated (solver->sharing, hash_clause (size, lits)))
+    {
+      INC (shared_filtered);
+      return 0;
+    }
+  assert (EMPTY_STACK (solver->clause));
+  const size_t imported = SIZE_STACK (solver->import);
+  const value *const values = solver->values;
+  for (unsigned i = 0; i < size; i++)
+    {
+      const int elit = lits[i];
+      const unsigned eidx = ABS (elit);
+      const import *import =
+	eidx < imported ? &PEEK_STACK (solver->import, eidx) : 0;
+      bool filter = !import || !import->imported || import->eliminated;
+      if (!filter)
+	{
+	  unsigned ilit = import->lit;
+	  if (elit < 0)
+	    ilit = NOT (ilit);
+	  const value value = values[ilit];
+	  if (value < 0)
+	    continue;
+	  filter = value > 0 || !ACTIVE (IDX (ilit));
+	  if (!filter)
+	    PUSH_STACK (solver->clause, ilit);
+	}
+      if (filter)
+	{
+	  CLEAR_STACK (solver->clause);
+	  INC (shared_filtered);
+	  return 0;
+	}
+    }
+  INC (shared_imported);
+  unsigned *ilits = BEGIN_STACK (solver->clause);
+  const unsigned simplified = SIZE_STACK (solver->clause);
+  ADD_UNCHECKED_INTERNAL (simplified, ilits);
+  int res = 0;
+  if (!simplified)
+    {
+      LOG ("imported empty clause");
+      solver->inconsistent = true;
+      CHECK_AND_ADD_EMPTY ();
+      ADD_EMPTY_TO_PROOF ();
+      res = 20;
+    }
+  else if (simplified == 1)
+    {
+      LOG ("imported unit %s", LOGLIT (ilits[0]));
+      kissat_learned_unit (solver, ilits[0]);
+      solver->iterating = true;
+      INC (shared_useful);
+    }
+  else if (simplified == 2)
+    kissat_new_binary_clause (solver, true, ilits[0], ilits[1]);
+  else
+    {
+      const unsigned glue = MIN (slot->glue, simplified - 1);
+      const reference ref = kissat_new_redundant_clause (solver, glue);
+      clause *c = kissat_dereference_clause (solver, ref);
+      c->shared = true;
+      COLD (c)->used = 1;
+    }
+  CLEAR_STACK (solver->clause);
+  return res;
+}
+
+int
+kissat_import_shared (kissat * solver)
+{
+  assert (!solver->level);
+  sharing *sharing = solver->sharing;
+  assert (sharing);
+  sharing->imported = CONFLICTS;
+  const exchange *exchange = sharing->exchange;
+  const uint64_t head = __atomic_load_n (&exchange->head, __ATOMIC_ACQUIRE);
+  uint64_t cursor = sharing->cursor;
+  if (head - cursor > SHARED_SLOTS)
+    cursor = head - SHARED_SLOTS;
+  int res = 0;
+  slot slot;
+  while (!res && cursor != head)
+    {
+      const uint64_t position = cursor++;
+      if (!read_slot (exchange, position, &slot))
+	continue;
+      if (slot.producer == sharing->id)
+	continue;
+      res = import_shared_clause (solver, &slot);
+    }
+  sharing->cursor = cursor;
+  return res;
+}
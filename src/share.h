@@ -0,0 +1,22 @@
+#ifndef _share_h_INCLUDED
+#define _share_h_INCLUDED
+
+#include <stdbool.h>
+
+typedef struct exchange exchange;
+typedef struct sharing sharing;
+
+struct kissat;
+
+exchange *kissat_new_exchange (struct kissat *);
+void kissat_delete_exchange (struct kissat *, exchange *);
+
+void kissat_connect_sharing (struct kissat *, exchange *, unsigned id);
+void kissat_release_sharing (struct kissat *);
+
+void kissat_export_shared (struct kissat *, unsigned glue);
+
+bool kissat_importing (struct kissat *);
+int kissat_import_shared (struct kissat *);
+
+#endif
@@ -0,0 +1,123 @@
+#include "attribute.h"
+#include "simd.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define SIMD_GATHER
+#include <immintrin.h>
+#endif
+
+static unsigned *
+scalar_search (const value * values, unsigned *p, const unsigned *end)
+{
+  while (p != end && values[*p] < 0)
+    p++;
+  return p;
+}
+
+#ifdef SIMD_GATHER
+
+// Gathers load 32-bit words, i.e., four values starting at the literal.  In
+// order not to read beyond the values of the last literals the gathered
+// addresses are clamped to 'lits - 4' and the value of the literal is then
+// shifted down from the byte it ends up in instead.  The sign bit of each
+// value tells whether the literal is false.
+
+static unsigned *avx2_search (const value *, unsigned,
+			      unsigned *, const unsigned *)
+ATTRIBUTE_TARGET ("avx2");
+
+static unsigned *
+avx2_search (const value * values, unsigned lits,
+	     unsigned *p, const unsigned *end)
+{
+  const int *const base = (const int *) values;
+  const __m256i limit = _mm256_set1_epi32 (lits - 4);
+  while (end - p >= 8)
+    {
+      const __m256i lit = _mm256_loadu_si256 ((const __m256i *) p);
+      const __m256i clamped = _mm256_min_epu32 (lit, limit);
+      const __m256i gathered = _mm256_i32gather_epi32 (base, clamped, 1);
+      const __m256i offset = _mm256_sub_epi32 (lit, clamped);
+      const __m256i bits = _mm256_slli_epi32 (offset, 3);
+      const __m256i shifted = _mm256_srlv_epi32 (gathered, bits);
+      const __m256i signs = _mm256_slli_epi32 (shifted, 24);
+      const unsigned negative =
+	_mm256_movemask_ps (_mm256_castsi256_ps (signs));
+      const unsigned non_false = ~negative & 0xff;
+      if (non_false)
+	return p + __builtin_ctz (non_false);
+      p += 8;
+    }
+  return scalar_search (values, p, end);
+}
+
+static unsigned *avx512_search (const value *, unsigned,
+				unsigned *, const unsigned *)
+ATTRIBUTE_TARGET ("avx512f");
+
+static unsigned *
+avx512_search (const value * values, unsigned lits,
+	       unsigned *p, const unsigned *end)
+{
+  const int *const base = (const int *) values;
+  const __m512i limit = _mm512_set1_epi32 (lits - 4);
+  const __m512i sign = _mm512_set1_epi32 (0x80);
+  while (end - p >= 16)
+    {
+      const __m512i lit = _mm512_loadu_si512 ((const void *) p);
+      const __m512i clamped = _mm512_min_epu32 (lit, limit);
+      const __m512i gathered = _mm512_i32gather_epi32 (clamped, base, 1);
+      const __m512i offset = _mm512_sub_epi32 (lit, clamped);
+      const __m512i bits = _mm512_slli_epi32 (offset, 3);
+      const __m512i shifted = _mm512_srlv_epi32 (gathered, bits);
+      const unsigned negative = _mm512_test_epi32_mask (shifted, sign);
+      const unsigned non_false = ~negative & 0xffff;
+      if (non_false)
+	return p + __builtin_ctz (non_false);
+      p += 16;
+    }
+  return scalar_search (values, p, end);
+}
+
+#endif
+
+unsigned
+kissat_simd_supported (void)
+{
+#ifdef SIMD_GATHER
+  if (__builtin_cpu_supports ("avx512f"))
+    return SIMD_AVX512;
+  if (__builtin_cpu_supports ("avx2"))
+    return SIMD_AVX2;
+#endif
+  return SIMD_SCALAR;
+}
+
+const char *
+kissat_simd_name (unsigned simd)
+{
+  if (simd == SIMD_AVX512)
+    return "AVX-512";
+  if (simd == SIMD_AVX2)
+    return "AVX2";
+  return "scalar";
+}
+
+unsigned *
+kissat_simd_search (unsigned simd, const value * values,
+		    unsigned lits, unsigned *begin, const unsigned *end)
+{
+#ifdef SIMD_GATHER
+  if (lits >= 4)
+    {
+      if (simd == SIMD_AVX512)
+	return avx512_search (values, lits, begin, end);
+      if (simd == SIMD_AVX2)
+	return avx2_search (values, lits, begin, end);
+    }
+#else
+  (void) simd;
+  (void) lits;
+#endif
+  return scalar_search (values, begin, end);
+}
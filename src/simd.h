@@ -0,0 +1,53 @@
+#ifndef _simd_h_INCLUDED
+#define _simd_h_INCLUDED
+
+#include "value.h"
+
+#include <stddef.h>
+
+// Searching for a replacement watch in long clauses can test the values of
+// several literals at once by gathering them with vector instructions.
+// The instruction set (AVX-512 or AVX2 on x86-64) is determined at run-time
+// and otherwise (or if disabled) the scalar search is used.
+
+#define SIMD_SCALAR 0
+#define SIMD_AVX2 1
+#define SIMD_AVX512 2
+
+// Replacements are usually found close to the 'searched' position.  Thus
+// the first literals are always searched with scalar code and vectors are
+// only used if at least 'SIMD_MIN_LITERALS' literals remain.
+
+#define SIMD_SCALAR_PREFIX 8
+#define SIMD_MIN_LITERALS 16
+
+unsigned kissat_simd_supported (void);
+const char *kissat_simd_name (unsigned);
+
+// Returns the first literal in '[begin,end)' which is not false or 'end'
+// if there is none.  Only the first 'lits' values are ever read.
+
+unsigned *kissat_simd_search (unsigned simd, const value * values,
+			      unsigned lits, unsigned *begin,
+			      const unsigned *end);
+
+static inline unsigned *
+kissat_search_non_false (unsigned simd, const value * values,
+			 unsigned lits, unsigned *begin, const unsigned *end)
+{
+  unsigned *p = begin;
+  if (simd && (size_t) (end - p) >= SIMD_SCALAR_PREFIX + SIMD_MIN_LITERALS)
+    {
+      const unsigned *const prefix = p + SIMD_SCALAR_PREFIX;
+      while (p != prefix && values[*p] < 0)
+	p++;
+      if (p != prefix)
+	return p;
+      return kissat_simd_search (simd, values, lits, p, end);
+    }
+  while (p != end && values[*p] < 0)
+    p++;
+  return p;
+}
+
+#endif
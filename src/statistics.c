@@ -58,6 +58,12 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PER_CONFLICT(NAME) \
   RELATIVE (NAME, conflicts)
 
+#define PER_DEFRAG(NAME) \
+  RELATIVE (NAME, defragmentations)
+
+#define PER_DEFRAG_STEP(NAME) \
+  RELATIVE (NAME, defrag_steps)
+
 #define PER_FIXED(NAME) \
   RELATIVE (NAME, units)
 
@@ -114,6 +120,9 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PCNT_CLS_ADDED(NAME) \
   PERCENT (NAME, clauses_added)
 
+#define PCNT_CLS_VISITED(NAME) \
+  PERCENT (NAME, clauses_visited)
+
 #define PCNT_COLLECTIONS(NAME) \
   PERCENT (NAME, garbage_collections)
 
@@ -168,6 +177,12 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PCNT_SEARCHES(NAME) \
   PERCENT (NAME, searches)
 
+#define PCNT_SHARED_IMPORTED(NAME) \
+  PERCENT (NAME, shared_imported)
+
+#define PCNT_SHARED_RECEIVED(NAME) \
+  PERCENT (NAME, shared_received)
+
 #define PCNT_STR(NAME) \
   PERCENT (NAME, strengthened)
 
@@ -255,7 +270,7 @@ kissat_check_statistics (kissat * solver)
     {
       if (c->garbage)
 	{
-	  arena_garbage += kissat_actual_bytes_of_clause (c);
+	  arena_garbage += kissat_actual_bytes_of_clause (solver, c);
 	  continue;
 	}
       if (c->redundant)
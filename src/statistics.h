@@ -23,6 +23,7 @@ METRIC( backbone_rounds, 2, PER_BACKBONE, 0, "per backbone") \
 COUNTER( backbone_ticks, 2, PCNT_TICKS, "%", "ticks") \
 STATISTIC( backbone_units, 1, PCNT_VARIABLES, "%", "variables") \
 METRIC( best_saved, 1, CONF_INT, "", "interval") \
+STATISTIC( checkpoints, 1, NO_SECONDARY, 0, 0) \
 STATISTIC( chronological, 1, PCNT_CONFLICTS, "%", "conflicts") \
 METRIC( clauses_added, 2, PCNT_CLS_ADDED, "%", "added") \
 METRIC( clauses_deleted, 2, PCNT_CLS_ADDED, "%", "added") \
@@ -32,10 +33,12 @@ METRIC( clauses_kept2, 2, PCNT_CLS_ADDED, "%", "added") \
 METRIC( clauses_kept3, 2, PCNT_CLS_ADDED, "%", "added") \
 METRIC( clauses_learned, 1, PCNT_CONFLICTS, "%", "conflicts") \
 METRIC( clauses_original, 2, PCNT_CLS_ADDED, "%", "added") \
+METRIC( clauses_prefetched, 2, PCNT_CLS_VISITED, "%", "visited") \
 METRIC( clauses_promoted1, 2, PCNT_CLS_ADDED, "%", "added") \
 METRIC( clauses_promoted2, 2, PCNT_CLS_ADDED, "%", "added") \
 METRIC( clauses_reduced, 2, PCNT_CLS_ADDED, "%", "added") \
 COUNTER( clauses_redundant, 2, NO_SECONDARY, 0, 0) \
+METRIC( clauses_visited, 2, PER_PROPAGATION, 0, "per prop") \
 METRIC( compacted, 1, PCNT_REDUCTIONS, "%", "reductions") \
 COUNTER( conflicts, 0, PER_SECOND, 0, "per second") \
 COUNTER( decisions, 0, PER_CONFLICT, 0, "per conflict") \
@@ -43,6 +46,10 @@ METRIC( definitions_checked, 1, PCNT_ELIM_ATTEMPTS, "%", "attempts") \
 STATISTIC( definitions_eliminated, 1, PCNT_ELIMINATED, "%", "eliminated") \
 METRIC( definitions_extracted, 1, PCNT_EXTRACTED, "%", "extracted") \
 STATISTIC( definition_units, 1, PCNT_VARIABLES, "%", "variables") \
+METRIC( defrag_freed, 1, PER_DEFRAG, 0, "per defrag") \
+METRIC( defrag_incremental, 1, PCNT_DEFRAGS, "%", "defrags") \
+METRIC( defrag_moved, 1, PER_DEFRAG_STEP, 0, "per step") \
+METRIC( defrag_steps, 1, PER_DEFRAG, 0, "per defrag") \
 METRIC( defragmentations, 1, CONF_INT, "", "interval") \
 METRIC( dense_garbage_collections, 2, PCNT_COLLECTIONS, "%", "collections") \
 METRIC( dense_propagations, 1, PCNT_PROPS, "%", "propagations") \
@@ -99,6 +106,8 @@ METRIC( probing_propagations, 1, PCNT_PROPS, "%", "propagations") \
 COUNTER( probings, 2, CONF_INT, "", "interval") \
 COUNTER( probing_ticks, 2, PCNT_TICKS, "%", "ticks") \
 COUNTER( propagations, 0, PER_SECOND, "", "per second") \
+STATISTIC( reactivated, 1, PCNT_VARIABLES, "%", "variables") \
+COUNTER( reclaims, 1, CONF_INT, "", "interval") \
 COUNTER( reductions, 1, CONF_INT, "", "interval") \
 COUNTER( rephased, 1, CONF_INT, "", "interval") \
 METRIC( rephased_best, 1, PCNT_REPHASED, "%", "rephased") \
@@ -107,10 +116,16 @@ METRIC( rephased_original, 1, PCNT_REPHASED, "%", "rephased") \
 METRIC( rephased_walking, 1, PCNT_REPHASED, "%", "rephased") \
 METRIC( rescaled, 2, CONF_INT, "", "interval") \
 COUNTER( restarts, 1, CONF_INT, 0, "interval") \
+STATISTIC( restored, 1, NO_SECONDARY, 0, 0) \
 METRIC( saved_decisions, 1, PCNT_DECISIONS, "%", "decisions") \
 COUNTER( searches, 2, CONF_INT, "", "interval") \
 METRIC( search_propagations, 2, PCNT_PROPS, "%", "propagations") \
 COUNTER( search_ticks, 2, PCNT_TICKS, "%", "ticks") \
+COUNTER( shared_exported, 1, PCNT_CONFLICTS, "%", "conflicts") \
+COUNTER( shared_filtered, 1, PCNT_SHARED_RECEIVED, "%", "received") \
+COUNTER( shared_imported, 1, PCNT_SHARED_RECEIVED, "%", "received") \
+COUNTER( shared_received, 1, NO_SECONDARY, 0, 0) \
+COUNTER( shared_useful, 1, PCNT_SHARED_IMPORTED, "%", "imported") \
 METRIC( sparse_garbage_collections, 2, PCNT_COLLECTIONS, "%", "collections") \
 METRIC( stable_decisions, 1, PCNT_DECISIONS, "%", "decisions") \
 METRIC( stable_modes, 2, CONF_INT, "", "interval") \
@@ -12,7 +12,7 @@ large_on_the_fly_strengthen (kissat * solver, clause * c, unsigned lit)
   assert (lits[0] == lit || lits[1] == lit);
   INC (on_the_fly_strengthened);
 #ifndef NDEBUG
-  clause *old_next = kissat_next_clause (c);
+  clause *old_next = kissat_next_clause (solver, c);
 #endif
   if (lits[0] == lit)
     SWAP (unsigned, lits[0], lits[1]);
@@ -38,11 +38,11 @@ large_on_the_fly_strengthen (kissat * solver, clause * c, unsigned lit)
     assert (new_size > 2);
     c->size = new_size;
     c->searched = 2;
-    if (c->redundant && c->glue >= new_size)
+    if (c->redundant && COLD (c)->glue >= new_size)
       kissat_promote_clause (solver, c, new_size - 1);
-    if (!c->shrunken)
+    if (!COLD (c)->shrunken)
       {
-	c->shrunken = true;
+	COLD (c)->shrunken = true;
 	lits[old_size - 1] = INVALID_LIT;
       }
   }
@@ -65,32 +65,43 @@ large_on_the_fly_strengthen (kissat * solver, clause * c, unsigned lit)
     if (highest_pos != 1)
       SWAP (unsigned, lits[1], lits[highest_pos]);
     LOGCLS (c, "sorted on-the-fly strengthened");
-    kissat_watch_blocking (solver, lits[1], lits[0], ref);
+    if (kissat_watching_ternary (solver, size))
+      kissat_watch_ternary (solver, lits[1], lits[0], lits[2], ref);
+    else
+      kissat_watch_blocking (solver, lits[1], lits[0], ref);
   }
-  {
-    watches *watches = &WATCHES (lits[0]);
+  if (kissat_watching_ternary (solver, c->size))
+    {
+      kissat_unwatch_blocking (solver, lits[0], ref);
+      kissat_watch_ternary (solver, lits[0], lits[1], lits[2], ref);
+    }
+  else
+    {
+      watches *watches = &WATCHES (lits[0]);
 #ifndef NDEBUG
-    const watch *const end_of_watches = END_WATCHES (*watches);
+      const watch *const end_of_watches = END_WATCHES (*watches);
 #endif
-    watch *p = BEGIN_WATCHES (*watches);
-    assert (solver->watching);
-    for (;;)
-      {
-	assert (p != end_of_watches);
-	const watch head = *p++;
-	if (head.type.binary)
-	  continue;
-	assert (p != end_of_watches);
-	const watch tail = *p++;
-	if (tail.large.ref == ref)
-	  break;
-      }
-    p[-2].blocking.lit = lits[1];
-    LOGREF (ref, "updating watching %s now blocking %s in",
-	    LOGLIT (lits[0]), LOGLIT (lits[1]));
-  }
+      watch *p = BEGIN_WATCHES (*watches);
+      assert (solver->watching);
+      for (;;)
+	{
+	  assert (p != end_of_watches);
+	  const watch head = *p++;
+	  if (head.type.binary)
+	    continue;
+	  assert (p != end_of_watches);
+	  const watch tail = *p++;
+	  if (head.type.ternary)
+	    p++;
+	  else if (tail.large.ref == ref)
+	    break;
+	}
+      p[-2].blocking.lit = lits[1];
+      LOGREF (ref, "updating watching %s now blocking %s in",
+	      LOGLIT (lits[0]), LOGLIT (lits[1]));
+    }
 #ifndef NDEBUG
-  clause *new_next = kissat_next_clause (c);
+  clause *new_next = kissat_next_clause (solver, c);
   assert (old_next == new_next);
 #endif
   LOGCLS (c, "conflicting");
@@ -127,7 +138,7 @@ binary_on_the_fly_strengthen (kissat * solver, clause * c, unsigned lit)
 	{
 	  assert (second == INVALID_LIT);
 	  second = other;
-#ifndef NDEBUG
+#ifdef NDEBUG
 	  break;
 #endif
 	}
@@ -177,10 +188,12 @@ kissat_on_the_fly_subsume (kissat * solver, clause * c, clause * d)
     {
       if (c->redundant && !c->keep)
 	{
-	  if (c->glue > d->glue)
-	    kissat_promote_clause (solver, c, d->glue);
-	  if (c->glue <= (unsigned) GET_OPTION (tier2) && c->used <= 1)
-	    c->used = 2;
+	  cold *const cold = COLD (c);
+	  const unsigned glue = COLD (d)->glue;
+	  if (cold->glue > glue)
+	    kissat_promote_clause (solver, c, glue);
+	  if (cold->glue <= (unsigned) GET_OPTION (tier2) && cold->used <= 1)
+	    cold->used = 2;
 	}
       return;
     }
@@ -195,8 +208,10 @@ kissat_on_the_fly_subsume (kissat * solver, clause * c, clause * d)
 	{
 	  const unsigned lit = lits[i];
 	  watches *watches = &WATCHES (lit);
-	  watch *p = LAST_WATCH_POINTER (*watches);
-	  assert (p->type.binary);
+	  watch *p = END_WATCHES (*watches);
+	  do
+	    assert (p != BEGIN_WATCHES (*watches));
+	  while (!(--p)->type.binary);
 	  assert (p->binary.redundant);
 	  assert (p->binary.lit == lits[!i]);
 	  p->binary.redundant = false;
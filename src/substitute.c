@@ -51,6 +51,7 @@ determine_representatives (kissat * solver, unsigned *repr)
   unsigned *reach = kissat_malloc (solver, LITS * sizeof *reach);
   watches *all_watches = solver->watches;
   const flags *const flags = solver->flags;
+  const bool *const frozen = solver->frozen;
   unsigned reached = 0;
   unsigneds scc;
   unsigneds work;
@@ -68,7 +69,8 @@ determine_representatives (kissat * solver, unsigned *repr)
 	break;
       if (mark[root])
 	continue;
-      if (!ACTIVE (IDX (root)))
+      const unsigned root_idx = IDX (root);
+      if (!flags[root_idx].active || frozen[root_idx])
 	continue;
       assert (EMPTY_STACK (scc));
       assert (EMPTY_STACK (work));
@@ -97,7 +99,7 @@ determine_representatives (kissat * solver, unsigned *repr)
 		    continue;
 		  const unsigned other = watch.binary.lit;
 		  const unsigned idx_other = IDX (other);
-		  if (!flags[idx_other].active)
+		  if (!flags[idx_other].active || frozen[idx_other])
 		    continue;
 		  assert (mark[other]);
 		  unsigned reach_other = reach[other];
@@ -188,7 +190,7 @@ determine_representatives (kissat * solver, unsigned *repr)
 		    continue;
 		  const unsigned other = watch.binary.lit;
 		  const unsigned idx_other = IDX (other);
-		  if (!flags[idx_other].active)
+		  if (!flags[idx_other].active || frozen[idx_other])
 		    continue;
 		  if (!mark[other])
 		    PUSH_STACK (work, other);
@@ -569,9 +571,9 @@ substitute_clauses (kissat * solver, unsigned *repr)
 		{
 		  c->size = new_size;
 		  c->searched = 2;
-		  if (!c->shrunken)
+		  if (!COLD (c)->shrunken)
 		    {
-		      c->shrunken = true;
+		      COLD (c)->shrunken = true;
 		      c->lits[old_size - 1] = INVALID_LIT;
 		    }
 		}
@@ -651,8 +653,6 @@ substitute_rounds (kissat * solver)
   if (!solver->inconsistent)
     {
       kissat_watch_large_clauses (solver);
-      LOG ("now all large clauses are watched after binary clauses");
-      solver->large_clauses_watched_after_binary_clauses = true;
       kissat_reset_propagate (solver);
       assert (!solver->level);
       (void) kissat_probing_propagate (solver, 0, true);
@@ -668,8 +668,6 @@ kissat_substitute (kissat * solver)
   assert (solver->probing);
   assert (solver->watching);
   assert (!solver->level);
-  LOG ("assuming not all large clauses watched after binary clauses");
-  solver->large_clauses_watched_after_binary_clauses = false;
   if (!GET_OPTION (substitute))
     return;
   if (TERMINATED (substitute_terminated_1))
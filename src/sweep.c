@@ -194,8 +194,8 @@ clear_sweeper (sweeper * sweeper)
   for (all_stack (reference, ref, sweeper->refs))
     {
       clause *c = kissat_dereference_clause (solver, ref);
-      assert (c->sweeped);
-      c->sweeped = false;
+      assert (COLD (c)->sweeped);
+      COLD (c)->sweeped = false;
     }
   CLEAR_STACK (sweeper->refs);
   CLEAR_STACK (sweeper->backbone);
@@ -303,7 +303,7 @@ sweep_reference (sweeper * sweeper, unsigned depth, reference ref)
   assert (EMPTY_STACK (sweeper->clause));
   kissat *solver = sweeper->solver;
   clause *c = kissat_dereference_clause (solver, ref);
-  if (c->sweeped)
+  if (COLD (c)->sweeped)
     return;
   if (c->garbage)
     return;
@@ -323,7 +323,7 @@ sweep_reference (sweeper * sweeper, unsigned depth, reference ref)
       PUSH_STACK (sweeper->clause, lit);
     }
   PUSH_STACK (sweeper->refs, ref);
-  c->sweeped = true;
+  COLD (c)->sweeped = true;
   sweep_clause (sweeper, depth);
 }
 
@@ -1048,7 +1048,7 @@ substitute_connected_clauses (sweeper * sweeper, unsigned lit, unsigned repr)
 					       src, dst);
 		dst.binary.lit = other;
 		PUSH_STACK (*delayed, dst.raw);
-		const size_t bytes = kissat_actual_bytes_of_clause (c);
+		const size_t bytes = kissat_actual_bytes_of_clause (solver, c);
 		ADD (arena_garbage, bytes);
 		c->garbage = true;
 		q--;
@@ -1074,11 +1074,11 @@ substitute_connected_clauses (sweeper * sweeper, unsigned lit, unsigned repr)
 	      {
 		c->size = new_size;
 		c->searched = 2;
-		if (c->redundant && c->glue >= new_size)
+		if (c->redundant && COLD (c)->glue >= new_size)
 		  kissat_promote_clause (solver, c, new_size - 1);
-		if (!c->shrunken)
+		if (!COLD (c)->shrunken)
 		  {
-		    c->shrunken = true;
+		    COLD (c)->shrunken = true;
 		    c->lits[old_size - 1] = INVALID_LIT;
 		  }
 	      }
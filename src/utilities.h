@@ -8,9 +8,11 @@
 
 typedef uintptr_t word;
 typedef uintptr_t w2rd[2];
+typedef uintptr_t w8rd[8];
 
 #define WORD_ALIGNMENT_MASK (sizeof (word)-1)
 #define W2RD_ALIGNMENT_MASK (sizeof (w2rd)-1)
+#define W8RD_ALIGNMENT_MASK (sizeof (w8rd)-1)
 
 #define WORD_FORMAT PRIuPTR
 
@@ -77,6 +79,15 @@ kissat_align_w2rd (word w)
   return res;
 }
 
+static inline word
+kissat_align_w8rd (word w)
+{
+  word res = w;
+  if (res & W8RD_ALIGNMENT_MASK)
+    res = 1 + (res | W8RD_ALIGNMENT_MASK);
+  return res;
+}
+
 bool kissat_has_suffix (const char *str, const char *suffix);
 
 static inline bool
@@ -42,69 +42,80 @@ do { \
 
 #endif
 
-unsigned *
-kissat_enlarge_vector (kissat * solver, vector * vector)
+static void
+enlarge_vectors (kissat * solver, size_t needed)
 {
   unsigneds *stack = &solver->vectors.stack;
-  const size_t old_vector_size = kissat_size_vector (vector);
-#ifdef LOGGING
-  const size_t old_offset = kissat_offset_vector (solver, vector);
-  LOG2 ("enlarging vector %zu[%zu] at %p",
-	old_offset, old_vector_size, (void *) vector);
-#endif
-  assert (old_vector_size < MAX_VECTORS / 2);
-  const size_t new_vector_size = old_vector_size ? 2 * old_vector_size : 1;
-  size_t old_stack_size = SIZE_STACK (*stack);
+  const size_t old_stack_size = SIZE_STACK (*stack);
   size_t capacity = CAPACITY_STACK (*stack);
   assert (kissat_is_power_of_two (MAX_VECTORS));
   assert (capacity <= MAX_VECTORS);
   size_t available = capacity - old_stack_size;
-  if (new_vector_size > available)
-    {
+  if (needed <= available)
+    return;
 #if !defined(QUIET) || !defined(COMPACT)
-      unsigned *old_begin_stack = BEGIN_STACK (*stack);
+  unsigned *old_begin_stack = BEGIN_STACK (*stack);
 #endif
-      unsigned enlarged = 0;
-      do
-	{
-	  assert (kissat_is_zero_or_power_of_two (capacity));
+  do
+    {
+      assert (kissat_is_zero_or_power_of_two (capacity));
 
-	  if (capacity == MAX_VECTORS)
-	    kissat_fatal ("maximum vector stack size "
-			  "of 2^%u entries %s exhausted", LD_MAX_VECTORS,
-			  FORMAT_BYTES (MAX_VECTORS * sizeof (unsigned)));
-	  enlarged++;
-	  kissat_stack_enlarge (solver, (chars *) stack, sizeof (unsigned));
+      if (capacity == MAX_VECTORS)
+	kissat_fatal ("maximum vector stack size "
+		      "of 2^%u entries %s exhausted", LD_MAX_VECTORS,
+		      FORMAT_BYTES (MAX_VECTORS * sizeof (unsigned)));
+      ACCOUNT (vectors, kissat_stack_enlarge (solver, (chars *) stack,
+					      sizeof (unsigned)));
 
-	  capacity = CAPACITY_STACK (*stack);
-	  available = capacity - old_stack_size;
-	}
-      while (new_vector_size > available);
+      capacity = CAPACITY_STACK (*stack);
+      available = capacity - old_stack_size;
+    }
+  while (needed > available);
 
-      if (enlarged)
-	{
-	  INC (vectors_enlarged);
+  INC (vectors_enlarged);
 #if !defined(QUIET) || !defined(COMPACT)
-	  unsigned *new_begin_stack = BEGIN_STACK (*stack);
-	  const ptrdiff_t moved =
-	    (char *) new_begin_stack - (char *) old_begin_stack;
+  unsigned *new_begin_stack = BEGIN_STACK (*stack);
+  const ptrdiff_t moved = (char *) new_begin_stack - (char *) old_begin_stack;
 #endif
 #ifndef QUIET
-	  kissat_phase (solver, "vectors",
-			GET (vectors_enlarged),
-			"enlarged to %s entries %s (%s)",
-			FORMAT_COUNT (capacity),
-			FORMAT_BYTES (capacity * sizeof (unsigned)),
-			(moved ? "moved" : "in place"));
+  kissat_phase (solver, "vectors",
+		GET (vectors_enlarged),
+		"enlarged to %s entries %s (%s)",
+		FORMAT_COUNT (capacity),
+		FORMAT_BYTES (capacity * sizeof (unsigned)),
+		(moved ? "moved" : "in place"));
 #endif
 #ifndef COMPACT
-	  if (moved)
-	    fix_vector_pointers_after_moving_stack (solver, moved);
+  if (moved)
+    fix_vector_pointers_after_moving_stack (solver, moved);
 #endif
-	}
-      assert (capacity <= MAX_VECTORS);
-      assert (new_vector_size <= available);
-    }
+  assert (capacity <= MAX_VECTORS);
+  assert (needed <= available);
+}
+
+void
+kissat_reserve_vectors (kissat * solver, size_t entries)
+{
+  LOG ("reserving space for %zu additional vector entries", entries);
+  const size_t size = SIZE_STACK (solver->vectors.stack);
+  if (entries > MAX_VECTORS - size)
+    entries = MAX_VECTORS - size;
+  enlarge_vectors (solver, entries);
+}
+
+unsigned *
+kissat_enlarge_vector (kissat * solver, vector * vector)
+{
+  unsigneds *stack = &solver->vectors.stack;
+  const size_t old_vector_size = kissat_size_vector (vector);
+#ifdef LOGGING
+  const size_t old_offset = kissat_offset_vector (solver, vector);
+  LOG2 ("enlarging vector %zu[%zu] at %p",
+	old_offset, old_vector_size, (void *) vector);
+#endif
+  assert (old_vector_size < MAX_VECTORS / 2);
+  const size_t new_vector_size = old_vector_size ? 2 * old_vector_size : 1;
+  enlarge_vectors (solver, new_vector_size);
   unsigned *begin_old_vector = kissat_begin_vector (solver, vector);
   unsigned *begin_new_vector = END_STACK (*stack);
   unsigned *middle_new_vector = begin_new_vector + old_vector_size;
@@ -166,12 +177,41 @@ rank_offset (vector * unsorted, unsigned i)
 #define RANK_OFFSET(A) \
   rank_offset (unsorted, (A))
 
+static inline void
+release_empty_vector (vector * vector)
+{
+  assert (kissat_empty_vector (vector));
+#ifdef COMPACT
+  vector->offset = 0;
+#else
+  vector->begin = vector->end = 0;
+#endif
+}
+
+static size_t
+sort_vectors (kissat * solver, size_t size_unsorted, vector * unsorted,
+	      unsigned *sorted)
+{
+  size_t size_sorted = 0;
+  for (unsigned i = 0; i < size_unsorted; i++)
+    {
+      vector *vector = unsorted + i;
+      if (kissat_empty_vector (vector))
+	release_empty_vector (vector);
+      else
+	sorted[size_sorted++] = i;
+    }
+  RADIX_SORT (unsigned, rank, size_sorted, sorted, RANK_OFFSET);
+  return size_sorted;
+}
+
 void
 kissat_defrag_vectors (kissat * solver,
 		       size_t size_unsorted, vector * unsorted)
 {
   unsigneds *stack = &solver->vectors.stack;
   const size_t size_vectors = SIZE_STACK (*stack);
+  kissat_release_defrag_vectors (solver);
   if (size_vectors < 2)
     return;
   START (defrag);
@@ -180,20 +220,8 @@ kissat_defrag_vectors (kissat * solver,
        size_vectors, CAPACITY_STACK (*stack), solver->vectors.usable);
   size_t bytes = size_unsorted * sizeof (unsigned);
   unsigned *sorted = kissat_malloc (solver, bytes);
-  unsigned size_sorted = 0;
-  for (unsigned i = 0; i < size_unsorted; i++)
-    {
-      vector *vector = unsorted + i;
-      if (kissat_empty_vector (vector))
-#ifdef COMPACT
-	vector->offset = 0;
-#else
-	vector->begin = vector->end = 0;
-#endif
-      else
-	sorted[size_sorted++] = i;
-    }
-  RADIX_SORT (unsigned, rank, size_sorted, sorted, RANK_OFFSET);
+  const size_t size_sorted =
+    sort_vectors (solver, size_unsorted, unsorted, sorted);
   unsigned *old_begin_stack = BEGIN_STACK (*stack);
   unsigned *p = old_begin_stack + 1;
   for (unsigned i = 0; i < size_sorted; i++)
@@ -223,20 +251,21 @@ kissat_defrag_vectors (kissat * solver,
       p = new_end_of_vector;
     }
   kissat_free (solver, sorted, bytes);
-#ifndef QUIET
   const size_t freed = END_STACK (*stack) - p;
+  ADD (defrag_freed, freed);
+#ifndef QUIET
   double freed_fraction = kissat_percent (freed, size_vectors);
   kissat_phase (solver, "defrag", GET (defragmentations),
 		"freed %zu usable entries %.0f%% thus %s",
 		freed, freed_fraction,
 		FORMAT_BYTES (freed * sizeof (unsigned)));
-  assert (freed == solver->vectors.usable);
 #endif
+  assert (freed == solver->vectors.usable);
   SET_END_OF_STACK (*stack, p);
 #ifndef COMPACT
   assert (old_begin_stack == BEGIN_STACK (*stack));
 #endif
-  SHRINK_STACK (*stack);
+  ACCOUNT (vectors, SHRINK_STACK (*stack));
 #ifndef COMPACT
   unsigned *new_begin_stack = BEGIN_STACK (*stack);
   const ptrdiff_t moved = (char *) new_begin_stack - (char *) old_begin_stack;
@@ -248,6 +277,249 @@ kissat_defrag_vectors (kissat * solver,
   STOP (defrag);
 }
 
+// Incremental defragmentation works in passes.  Each pass sorts the
+// vectors beyond the 'frontier', i.e., the end of the already compacted
+// prefix of the stack, by offset.  Then each step slides a bounded number
+// of entries of the next vectors down to the frontier.  Between steps
+// vectors may grow, shrink or be moved to the end of the stack.  Thus a
+// vector is only moved if all the slots it is moved to are invalid
+// (unused) or its own, which keeps this safe no matter what happened in
+// between.  Only the last moved vector can grow in place beyond the
+// frontier, which we take into account at the start of a step.  Vectors
+// moved to the end of the stack during a pass are compacted by the next
+// pass as long as the number of entries in vectors beyond the frontier
+// decreases.  If these fit into one slice they are moved immediately
+// without further search in between, which allows to trim the stack.
+// Otherwise, if the stack is still too fragmented after the last pass, we
+// fall back to full defragmentation.
+
+void
+kissat_release_defrag_vectors (kissat * solver)
+{
+  defrag *defrag = &solver->vectors.defrag;
+  RELEASE_STACK (defrag->sorted);
+  defrag->next = defrag->frontier = defrag->remainder = 0;
+  defrag->last = INVALID_VECTOR_ELEMENT;
+}
+
+static inline void
+set_vector_begin (kissat * solver, vector * vector, unsigned *begin)
+{
+#ifdef COMPACT
+  const size_t offset = begin - BEGIN_STACK (solver->vectors.stack);
+  assert (offset <= UINT_MAX);
+  vector->offset = offset;
+#else
+  (void) solver;
+  vector->end = begin + kissat_size_vector (vector);
+  vector->begin = begin;
+#endif
+}
+
+static size_t
+move_vector_to_frontier (kissat * solver, vector * vector, size_t size)
+{
+  defrag *defrag = &solver->vectors.defrag;
+  unsigned *const begin_stack = BEGIN_STACK (solver->vectors.stack);
+  unsigned *const dst = begin_stack + defrag->frontier;
+  unsigned *const src = kissat_begin_vector (solver, vector);
+  if (src < dst)
+    return 0;
+  if (src > dst)
+    {
+      unsigned *const end_dst = dst + size;
+      unsigned *const limit = src < end_dst ? src : end_dst;
+      for (const unsigned *p = dst; p != limit; p++)
+	if (*p != INVALID_VECTOR_ELEMENT)
+	  return 0;
+      memmove (dst, src, size * sizeof (unsigned));
+      unsigned *const end_src = src + size;
+      unsigned *const vacated = src < end_dst ? end_dst : src;
+      memset (vacated, 0xff, (end_src - vacated) * sizeof (unsigned));
+      set_vector_begin (solver, vector, dst);
+    }
+  defrag->frontier += size;
+  return src > dst ? size : 0;
+}
+
+static void
+trim_vectors (kissat * solver)
+{
+  unsigneds *stack = &solver->vectors.stack;
+  unsigned *const begin = BEGIN_STACK (*stack);
+  unsigned *const end = END_STACK (*stack);
+  unsigned *p = end;
+  while (p - begin > 1 && p[-1] == INVALID_VECTOR_ELEMENT)
+    p--;
+  const size_t freed = end - p;
+  assert (freed <= solver->vectors.usable);
+  solver->vectors.usable -= freed;
+  ADD (defrag_freed, freed);
+  SET_END_OF_STACK (*stack, p);
+}
+
+static size_t
+start_defrag_pass (kissat * solver, size_t size_unsorted, vector * unsorted)
+{
+  defrag *defrag = &solver->vectors.defrag;
+  unsigneds *sorted = &defrag->sorted;
+  CLEAR_STACK (*sorted);
+  defrag->next = 0;
+  const unsigned *const begin_stack = BEGIN_STACK (solver->vectors.stack);
+  size_t entries = 0;
+  for (unsigned i = 0; i < size_unsorted; i++)
+    {
+      vector *vector = unsorted + i;
+      if (kissat_empty_vector (vector))
+	release_empty_vector (vector);
+      else if ((size_t) (kissat_begin_vector (solver, vector) -
+			 begin_stack) >= defrag->frontier)
+	{
+	  entries += kissat_size_vector (vector);
+	  PUSH_STACK (*sorted, i);
+	}
+    }
+  RADIX_STACK (unsigned, rank, *sorted, RANK_OFFSET);
+  LOG ("starting incremental defragmentation pass "
+       "on %zu vectors with %zu entries", SIZE_STACK (*sorted), entries);
+  return entries;
+}
+
+static void
+finish_defrag_vectors (kissat * solver)
+{
+  unsigneds *stack = &solver->vectors.stack;
+#ifndef QUIET
+  const size_t size = SIZE_STACK (*stack);
+  const size_t usable = solver->vectors.usable;
+  kissat_phase (solver, "defrag", GET (defragmentations),
+		"incrementally compacted to %s entries %s "
+		"with %zu usable %.0f%%", FORMAT_COUNT (size),
+		FORMAT_BYTES (size * sizeof (unsigned)),
+		usable, kissat_percent (usable, size));
+#endif
+  unsigned *const old_begin_stack = BEGIN_STACK (*stack);
+  ACCOUNT (vectors, SHRINK_STACK (*stack));
+#ifndef COMPACT
+  unsigned *new_begin_stack = BEGIN_STACK (*stack);
+  const ptrdiff_t moved = (char *) new_begin_stack - (char *) old_begin_stack;
+  if (moved)
+    fix_vector_pointers_after_moving_stack (solver, moved);
+#else
+  (void) old_begin_stack;
+#endif
+  kissat_release_defrag_vectors (solver);
+}
+
+static size_t
+move_vectors (kissat * solver, size_t size_unsorted, vector * unsorted,
+	      size_t limit)
+{
+  defrag *defrag = &solver->vectors.defrag;
+  const unsigned *const begin_stack = BEGIN_STACK (solver->vectors.stack);
+  if (defrag->last < size_unsorted)
+    {
+      vector *last = unsorted + defrag->last;
+      const unsigned *const begin = kissat_begin_vector (solver, last);
+      if (begin > begin_stack
+	  && (size_t) (begin - begin_stack) < defrag->frontier)
+	defrag->frontier = (begin - begin_stack) + kissat_size_vector (last);
+    }
+  const unsigned *const sorted = BEGIN_STACK (defrag->sorted);
+  const size_t size_sorted = SIZE_STACK (defrag->sorted);
+  size_t next = defrag->next, moved = 0;
+  while (next < size_sorted && moved < limit)
+    {
+      const unsigned idx = sorted[next++];
+      if (idx >= size_unsorted)
+	continue;
+      vector *vector = unsorted + idx;
+      const size_t size = kissat_size_vector (vector);
+      if (!size)
+	{
+	  release_empty_vector (vector);
+	  continue;
+	}
+      const size_t old_frontier = defrag->frontier;
+      moved += move_vector_to_frontier (solver, vector, size);
+      if (defrag->frontier != old_frontier)
+	defrag->last = idx;
+    }
+  defrag->next = next;
+  ADD (defrag_moved, moved);
+  LOG ("incremental defragmentation moved %zu entries", moved);
+  return moved;
+}
+
+static bool
+next_defrag_pass (kissat * solver, size_t size_unsorted, vector * unsorted)
+{
+  defrag *defrag = &solver->vectors.defrag;
+  const size_t slice = GET_OPTION (defragslice);
+  for (;;)
+    {
+      trim_vectors (solver);
+      if (!solver->vectors.usable)
+	break;
+      const size_t remainder =
+	start_defrag_pass (solver, size_unsorted, unsorted);
+      if (!remainder || remainder >= defrag->remainder)
+	break;
+      defrag->remainder = remainder;
+      if (remainder > slice)
+	return true;
+      (void) move_vectors (solver, size_unsorted, unsorted, SIZE_MAX);
+    }
+  finish_defrag_vectors (solver);
+  const size_t size = SIZE_STACK (solver->vectors.stack);
+  const size_t limit = (size * GET_OPTION (defraglim)) / 100;
+  if (solver->vectors.usable > limit)
+    {
+      LOG ("incremental defragmentation too slow");
+      kissat_defrag_vectors (solver, size_unsorted, unsorted);
+    }
+  return false;
+}
+
+void
+kissat_start_defrag_vectors (kissat * solver,
+			     size_t size_unsorted, vector * unsorted)
+{
+  defrag *defrag = &solver->vectors.defrag;
+  kissat_release_defrag_vectors (solver);
+  const size_t size = SIZE_STACK (solver->vectors.stack);
+  if (size < 2)
+    return;
+  START (defrag);
+  INC (defragmentations);
+  INC (defrag_incremental);
+  LOG ("starting incremental defragmentation of vectors "
+       "size %zu capacity %zu usable %zu", size,
+       CAPACITY_STACK (solver->vectors.stack), solver->vectors.usable);
+  defrag->frontier = 1;
+  defrag->remainder = SIZE_MAX;
+  (void) next_defrag_pass (solver, size_unsorted, unsorted);
+  STOP (defrag);
+}
+
+bool
+kissat_defrag_vectors_step (kissat * solver,
+			    size_t size_unsorted, vector * unsorted)
+{
+  defrag *defrag = &solver->vectors.defrag;
+  assert (!EMPTY_STACK (defrag->sorted));
+  START (defrag);
+  INC (defrag_steps);
+  const size_t slice = GET_OPTION (defragslice);
+  (void) move_vectors (solver, size_unsorted, unsorted, slice);
+  bool finished = false;
+  if (defrag->next == SIZE_STACK (defrag->sorted))
+    finished = !next_defrag_pass (solver, size_unsorted, unsorted);
+  kissat_check_vectors (solver);
+  STOP (defrag);
+  return finished;
+}
+
 void
 kissat_remove_from_vector (kissat * solver, vector * vector, unsigned remove)
 {
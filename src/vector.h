@@ -18,13 +18,32 @@
 
 #define MAX_SECTOR MAX_SIZE_T
 
+typedef struct defrag defrag;
 typedef struct vector vector;
 typedef struct vectors vectors;
 
+// State of an incremental defragmentation.  The 'sorted' stack holds the
+// indices of the vectors to be moved in the current pass ordered by their
+// offset at the start of the pass.  Vectors before 'next' have been moved
+// down to the stack prefix ending at offset 'frontier', 'last' is the index
+// of the last moved vector and 'remainder' the number of entries in the
+// vectors beyond the frontier at the start of the pass.
+
+struct defrag
+{
+  unsigneds sorted;
+  size_t next;
+  size_t frontier;
+  size_t remainder;
+  unsigned last;
+  uint64_t conflicts;
+};
+
 struct vectors
 {
   unsigneds stack;
   size_t usable;
+  defrag defrag;
 };
 
 struct vector
@@ -48,7 +67,11 @@ void kissat_check_vectors (struct kissat *);
 
 unsigned *kissat_enlarge_vector (struct kissat *, vector *);
 void kissat_defrag_vectors (struct kissat *, size_t, vector *);
+void kissat_start_defrag_vectors (struct kissat *, size_t, vector *);
+bool kissat_defrag_vectors_step (struct kissat *, size_t, vector *);
+void kissat_release_defrag_vectors (struct kissat *);
 void kissat_remove_from_vector (struct kissat *, vector *, unsigned);
 void kissat_resize_vector (struct kissat *, vector *, size_t);
+void kissat_reserve_vectors (struct kissat *, size_t);
 
 #endif
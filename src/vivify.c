@@ -127,11 +127,11 @@ simplify_vivification_candidate (kissat * solver, clause * const c)
       c->size = new_size;
       c->searched = 2;
       assert (c->redundant);
-      if (c->glue >= new_size)
+      if (COLD (c)->glue >= new_size)
 	kissat_promote_clause (solver, c, new_size - 1);
-      if (!c->shrunken)
+      if (!COLD (c)->shrunken)
 	{
-	  c->shrunken = true;
+	  COLD (c)->shrunken = true;
 	  lits[old_size - 1] = INVALID_LIT;
 	}
       LOGCLS (c, "vivification shrunken candidate");
@@ -163,11 +163,11 @@ schedule_vivification_candidates (kissat * solver,
 	    count_clause (c, counts);
 	  if (!c->redundant)
 	    continue;
-	  if (c->glue < lower_glue_limit)
+	  if (COLD (c)->glue < lower_glue_limit)
 	    continue;
-	  if (c->glue > upper_glue_limit)
+	  if (COLD (c)->glue > upper_glue_limit)
 	    continue;
-	  if (c->vivify != prioritize)
+	  if (COLD (c)->vivify != prioritize)
 	    continue;
 	  if (simplify_vivification_candidate (solver, c))
 	    continue;
@@ -194,7 +194,7 @@ schedule_vivification_candidates (kissat * solver,
 	{
 	  clause *c = (clause *) (arena + ref);
 	  assert (kissat_clause_in_arena (solver, c));
-	  c->vivify = true;
+	  COLD (c)->vivify = true;
 	}
     }
 }
@@ -205,10 +205,10 @@ worse_candidate (kissat * solver, unsigned *counts, reference r, reference s)
   const clause *const c = kissat_dereference_clause (solver, r);
   const clause *const d = kissat_dereference_clause (solver, s);
 
-  if (!c->vivify && d->vivify)
+  if (!COLD (c)->vivify && COLD (d)->vivify)
     return true;
 
-  if (c->vivify && !d->vivify)
+  if (COLD (c)->vivify && !COLD (d)->vivify)
     return false;
 
   unsigned const *p = BEGIN_LITS (c);
@@ -593,13 +593,13 @@ vivify_learn (kissat * solver, clause * c,
 	    }
 	  assert (new_size < old_size);
 	  assert (new_size == size);
-	  if (!c->shrunken)
+	  if (!COLD (c)->shrunken)
 	    {
-	      c->shrunken = true;
+	      COLD (c)->shrunken = true;
 	      lits[old_size - 1] = INVALID_LIT;
 	    }
 	  c->size = new_size;
-	  if (c->redundant && c->glue >= new_size)
+	  if (c->redundant && COLD (c)->glue >= new_size)
 	    kissat_promote_clause (solver, c, new_size - 1);
 	  c->searched = 2;
 	  LOGCLS (c, "vivified shrunken");
@@ -610,8 +610,7 @@ vivify_learn (kissat * solver, clause * c,
 
 	  kissat_unwatch_blocking (solver, watched[0], ref);
 	  kissat_unwatch_blocking (solver, watched[1], ref);
-	  kissat_watch_blocking (solver, lits[0], lits[1], ref);
-	  kissat_watch_blocking (solver, lits[1], lits[0], ref);
+	  kissat_watch_clause (solver, c);
 
 	  vivify_inc_strengthened (solver);
 	  res = true;
@@ -972,7 +971,7 @@ vivify_round (kissat * solver, bool tier2, uint64_t delta, double effort)
       tried++;
       if (vivify_clause (solver, c, &sorted, counts))
 	vivified++;
-      c->vivify = false;
+      COLD (c)->vivify = false;
       if (solver->inconsistent)
 	break;
     }
@@ -1000,7 +999,7 @@ vivify_round (kissat * solver, bool tier2, uint64_t delta, double effort)
 	    {
 	      const unsigned ref = POP_STACK (schedule);
 	      clause *c = (clause *) (arena + ref);
-	      if (c->vivify)
+	      if (COLD (c)->vivify)
 		prioritized++;
 	    }
 	  if (!prioritized)
@@ -195,7 +195,8 @@ init_score_table (walker * walker)
   for (next = 1; next; next *= base)
     exponents++;
 
-  walker->table = kissat_malloc (solver, exponents * sizeof (double));
+  ACCOUNT (walk, walker->table =
+	   kissat_malloc (solver, exponents * sizeof (double)));
 
   unsigned i = 0;
   double epsilon;
@@ -436,12 +437,14 @@ init_walker (kissat * solver, walker * walker, litpairs * binaries)
   walker->random = solver->random ^ solver->statistics.walks;
 
   walker->saved = solver->values;
-  solver->values = kissat_calloc (solver, LITS, 1);
+  ACCOUNT (walk, solver->values = kissat_calloc (solver, LITS, 1));
 
   import_decision_phases (walker);
 
-  walker->counters = kissat_malloc (solver, clauses * sizeof (counter));
-  walker->refs = kissat_malloc (solver, clauses * sizeof (tagged));
+  ACCOUNT (walk, walker->counters =
+	   kissat_malloc (solver, clauses * sizeof (counter)));
+  ACCOUNT (walk, walker->refs =
+	   kissat_malloc (solver, clauses * sizeof (tagged)));
 
   assert (!walker->size);
   const unsigned counter_ref = connect_binary_counters (walker);
@@ -482,14 +485,17 @@ static void
 release_walker (walker * walker)
 {
   kissat *solver = walker->solver;
-  kissat_dealloc (solver, walker->table, walker->exponents, sizeof (double));
+  ACCOUNT (walk, kissat_dealloc (solver, walker->table,
+				 walker->exponents, sizeof (double)));
   unsigned clauses = walker->clauses;
-  kissat_dealloc (solver, walker->refs, clauses, sizeof (tagged));
-  kissat_dealloc (solver, walker->counters, clauses, sizeof (counter));
+  ACCOUNT (walk, kissat_dealloc (solver, walker->refs,
+				 clauses, sizeof (tagged)));
+  ACCOUNT (walk, kissat_dealloc (solver, walker->counters,
+				 clauses, sizeof (counter)));
   RELEASE_STACK (walker->unsat);
   RELEASE_STACK (walker->scores);
   RELEASE_STACK (walker->trail);
-  kissat_free (solver, solver->values, LITS);
+  ACCOUNT (walk, kissat_free (solver, solver->values, LITS));
   RELEASE_STACK (walker->unsat);
   solver->values = walker->saved;
 }
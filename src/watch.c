@@ -3,6 +3,34 @@
 #include "inline.h"
 #include "sort.c"
 
+#include <string.h>
+
+void
+kissat_move_binary_watch_before_large_watches (kissat * solver,
+					       watches * watches)
+{
+  assert (solver->watching);
+  watch *const begin = BEGIN_WATCHES (*watches);
+  watch *const last = END_WATCHES (*watches) - 1;
+  assert (begin <= last);
+  const watch binary = *last;
+  assert (binary.type.binary);
+  // Search the first large watch from both ends at once, which takes time
+  // linear in the smaller of the binary and large parts, and then shift the
+  // large watches (all by the same single word) with one 'memmove'.
+  watch *front = begin, *back = last;
+  while (front != last && front->type.binary &&
+	 back != begin && !back[-1].type.binary)
+    front++, back--;
+  watch *const first_large =
+    (front == last || !front->type.binary) ? front : back;
+  const size_t large = last - first_large;
+  if (!large)
+    return;
+  memmove (first_large + 1, first_large, large * sizeof *first_large);
+  *first_large = binary;
+}
+
 void
 kissat_remove_blocking_watch (kissat * solver,
 			      watches * watches, reference ref)
@@ -12,34 +40,33 @@ kissat_remove_blocking_watch (kissat * solver,
   watch *const end = END_WATCHES (*watches);
   watch *q = begin;
   watch const *p = q;
-#ifndef NDEBUG
-  bool found = false;
-#endif
+  unsigned removed = 0;
   while (p != end)
     {
       const watch head = *q++ = *p++;
       if (head.type.binary)
 	continue;
       const watch tail = *q++ = *p++;
+      if (head.type.ternary)
+	*q++ = *p++;
       if (tail.raw != ref)
 	continue;
-#ifndef NDEBUG
-      assert (!found);
-      found = true;
-#endif
-      q -= 2;
+      assert (!removed);
+      removed = kissat_watch_words (head);
+      q -= removed;
     }
-  assert (found);
+  assert (removed);
 #ifdef COMPACT
-  watches->size -= 2;
+  watches->size -= removed;
 #else
-  assert (begin + 2 <= end);
-  watches->end -= 2;
+  assert (begin + removed <= end);
+  watches->end -= removed;
 #endif
   const watch empty = {.raw = INVALID_VECTOR_ELEMENT };
-  end[-2] = end[-1] = empty;
-  assert (solver->vectors.usable < MAX_SECTOR - 2);
-  solver->vectors.usable += 2;
+  for (watch * r = end - removed; r != end; r++)
+    *r = empty;
+  assert (solver->vectors.usable < MAX_SECTOR - removed);
+  solver->vectors.usable += removed;
   kissat_check_vectors (solver);
 }
 
@@ -106,11 +133,7 @@ kissat_watch_large_clauses (kissat * solver)
       c->searched = 2;
 
       const reference ref = (ward *) c - arena;
-      const unsigned l0 = lits[0];
-      const unsigned l1 = lits[1];
-
-      kissat_push_blocking_watch (solver, watches + l0, l1, ref);
-      kissat_push_blocking_watch (solver, watches + l1, l0, ref);
+      kissat_push_clause_watches (solver, watches, c, ref);
     }
 }
 
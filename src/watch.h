@@ -19,11 +19,11 @@ struct watch_type
 {
 #ifdef KISSAT_IS_BIG_ENDIAN
   bool binary:1;
-  unsigned padding:1;
+  bool ternary:1;
   unsigned lit:30;
 #else
   unsigned lit:30;
-  unsigned padding:1;
+  bool ternary:1;
   bool binary:1;
 #endif
 };
@@ -56,11 +56,11 @@ struct blocking_watch
 {
 #ifdef KISSAT_IS_BIG_ENDIAN
   bool binary:1;
-  unsigned padding:1;
+  bool ternary:1;
   unsigned lit:30;
 #else
   unsigned lit:30;
-  unsigned padding:1;
+  bool ternary:1;
   bool binary:1;
 #endif
 };
@@ -130,12 +130,41 @@ kissat_blocking_watch (unsigned lit)
 {
   watch res;
   res.blocking.lit = lit;
-  res.blocking.padding = 0;
+  res.blocking.ternary = false;
   res.blocking.binary = false;
   assert (!res.type.binary);
   return res;
 }
 
+// While watching clauses, watches of large clauses with three literals
+// consist of three words: the first other literal marked as 'ternary', the
+// clause reference (as for other large clauses) and then the second other
+// literal.  As for all large clauses the two watched literals are the
+// first two literals in the arena, but propagation only needs to access
+// the arena if the watch has to be moved or the clause became unit or
+// conflicting.  Watches of clauses with more literals consist of a blocking
+// literal (not marked 'ternary') and the clause reference.
+
+static inline watch
+kissat_ternary_watch (unsigned lit)
+{
+  watch res;
+  res.blocking.lit = lit;
+  res.blocking.ternary = true;
+  res.blocking.binary = false;
+  assert (!res.type.binary);
+  assert (res.type.ternary);
+  return res;
+}
+
+// Number of words of a watch starting with 'head' in watching mode.
+
+static inline unsigned
+kissat_watch_words (watch head)
+{
+  return head.type.binary ? 1 : head.type.ternary ? 3 : 2;
+}
+
 #define EMPTY_WATCHES(W) kissat_empty_vector (&W)
 #define SIZE_WATCHES(W) kissat_size_vector (&W)
 
@@ -145,9 +174,6 @@ do { \
   kissat_push_vectors (solver, &(W), (E).raw); \
 } while (0)
 
-#define LAST_WATCH_POINTER(WS) \
-  (watch *) kissat_last_vector_pointer (solver, &WS)
-
 #define BEGIN_WATCHES(WS) \
   ((union watch*) kissat_begin_vector (solver, &(WS)))
 
@@ -184,14 +210,14 @@ do { \
     ((WATCH = *WATCH ## _PTR), \
      (REF = WATCH.type.binary ? INVALID_REF : \
 	    WATCH ## _PTR[1].large.ref), true); \
-  WATCH ## _PTR += 1u + !WATCH.type.binary
+  WATCH ## _PTR += kissat_watch_words (WATCH)
 
 #define all_binary_blocking_watches(WATCH,WATCHES) \
   watch WATCH, \
     * WATCH ## _PTR = (assert (solver->watching), BEGIN_WATCHES (WATCHES)), \
     * const WATCH ## _END = END_WATCHES (WATCHES); \
   WATCH ## _PTR != WATCH ## _END && ((WATCH = *WATCH ## _PTR), true); \
-  WATCH ## _PTR += 1u + !WATCH.type.binary
+  WATCH ## _PTR += kissat_watch_words (WATCH)
 
 #define all_binary_large_watches(WATCH,WATCHES) \
   watch WATCH, \
@@ -200,6 +226,14 @@ do { \
   WATCH ## _PTR != WATCH ## _END && ((WATCH = *WATCH ## _PTR), true); \
   ++WATCH ## _PTR
 
+// While watching clauses all binary watches of a literal precede its large
+// clause watches.  This allows propagation to visit binary clauses first
+// and to stop at the first large watch.  Only binary watches are added
+// out of order and are thus moved in front of the large watches.
+
+void kissat_move_binary_watch_before_large_watches (struct kissat *,
+						    watches *);
+
 void kissat_remove_blocking_watch (struct kissat *, watches *, reference);
 
 void kissat_substitute_large_watch (struct kissat *, watches *,
@@ -9,7 +9,7 @@ push_witness_literal (kissat * solver, unsigned ilit)
   assert (elit);
   LOG2 ("pushing external witness literal %d on extension stack", elit);
   const extension ext = kissat_extension (true, elit);
-  PUSH_STACK (solver->extend, ext);
+  ACCOUNT (extend, PUSH_STACK (solver->extend, ext));
 }
 
 static void
@@ -26,7 +26,7 @@ push_clause_literal (kissat * solver, unsigned ilit)
       assert (elit);
       LOG2 ("pushing external clause literal %d on extension stack", elit);
       const extension ext = kissat_extension (false, elit);
-      PUSH_STACK (solver->extend, ext);
+      ACCOUNT (extend, PUSH_STACK (solver->extend, ext));
     }
 }
 
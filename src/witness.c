@@ -3,46 +3,80 @@
 #include "witness.h"
 
 #include <stdio.h>
-#include <string.h>
+
+// The witness is formatted into a large buffer, which is only written when
+// full, instead of printing every literal separately.  Lines are broken
+// as before, such that they never exceed 78 characters.
+
+#define WITNESS_BUFFER_SIZE (1u << 20)
+#define WITNESS_LINE_LENGTH 77
+
+typedef struct witness witness;
+
+struct witness
+{
+  char *begin, *end, *limit;
+  unsigned line;
+};
 
 static void
-flush_buffer (chars * buffer)
+flush_witness (witness * witness)
 {
-  fputs ("v", stdout);
-  for (all_stack (char, ch, *buffer))
-      fputc (ch, stdout);
-  fputc ('\n', stdout);
-  CLEAR_STACK (*buffer);
+  const size_t bytes = witness->end - witness->begin;
+  fwrite (witness->begin, 1, bytes, stdout);
+  witness->end = witness->begin;
 }
 
 static void
-print_int (kissat * solver, chars * buffer, int i)
+print_int (witness * witness, int i)
 {
-  char tmp[16];
-  sprintf (tmp, " %d", i);
-  size_t tmp_len = strlen (tmp);
-  size_t buf_len = SIZE_STACK (*buffer);
-  if (buf_len + tmp_len > 77)
-    flush_buffer (buffer);
-  for (const char *p = tmp; *p; p++)
-    PUSH_STACK (*buffer, *p);
+  char tmp[16], *p = tmp + sizeof tmp;
+  unsigned u = i < 0 ? -(unsigned) i : (unsigned) i;
+  do
+    *--p = '0' + u % 10;
+  while (u /= 10);
+  if (i < 0)
+    *--p = '-';
+  *--p = ' ';
+  const unsigned len = tmp + sizeof tmp - p;
+  if (witness->end > witness->limit)
+    flush_witness (witness);
+  char *q = witness->end;
+  if (witness->line + len > WITNESS_LINE_LENGTH)
+    {
+      *q++ = '\n';
+      *q++ = 'v';
+      witness->line = 0;
+    }
+  witness->line += len;
+  while (p != tmp + sizeof tmp)
+    *q++ = *p++;
+  witness->end = q;
 }
 
 void
 kissat_print_witness (kissat * solver, int max_var, bool partial)
 {
-  chars buffer;
-  INIT_STACK (buffer);
+  int *values;
+  NALLOC (values, max_var);
+  kissat_values (solver, values, max_var);
+  witness witness;
+  NALLOC (witness.begin, WITNESS_BUFFER_SIZE);
+  witness.limit = witness.begin + WITNESS_BUFFER_SIZE - 32;
+  witness.end = witness.begin;
+  *witness.end++ = 'v';
+  witness.line = 0;
   for (int eidx = 1; eidx <= max_var; eidx++)
     {
-      int tmp = kissat_value (solver, eidx);
+      int tmp = values[eidx - 1];
       if (!tmp && !partial)
 	tmp = eidx;
       if (tmp)
-	print_int (solver, &buffer, tmp);
+	print_int (&witness, tmp);
     }
-  print_int (solver, &buffer, 0);
-  assert (!EMPTY_STACK (buffer));
-  flush_buffer (&buffer);
-  RELEASE_STACK (buffer);
+  print_int (&witness, 0);
+  *witness.end++ = '\n';
+  flush_witness (&witness);
+  DEALLOC (witness.begin, WITNESS_BUFFER_SIZE);
+  DEALLOC (values, max_var);
 }
@@ -493,6 +493,7 @@ do { \
   SCHEDULE (vector);
   SCHEDULE (rank);
   SCHEDULE (sort);
+  SCHEDULE (simd);
   SCHEDULE (bump);
   SCHEDULE (options);
   SCHEDULE (config);
@@ -505,8 +506,12 @@ do { \
   SCHEDULE (collect);
   SCHEDULE (kitten);
   SCHEDULE (solve);
+  SCHEDULE (incremental);
   SCHEDULE (coverage);
   SCHEDULE (terminate);
+  SCHEDULE (proof);
+  SCHEDULE (checkpoint);
+  SCHEDULE (portfolio);
 
 #ifndef NPROOFS
   if (tissat_found_drabt || tissat_found_drat_trim)
@@ -1,5 +1,7 @@
 #include "test.h"
 
+#include <stdlib.h>
+
 static word full_clauses;
 
 static void
@@ -41,8 +43,68 @@ test_add (void)
     }
 }
 
+static size_t
+collect_full_clauses (int *lits, int *clause, int i, int n)
+{
+  assert (0 < i);
+  assert (i <= n);
+  size_t res = 0;
+  for (int sign = -1; sign <= 1; sign += 2)
+    {
+      clause[i] = sign * i;
+      if (i == n)
+	{
+	  for (int j = 1; j <= i; j++)
+	    lits[res++] = clause[j];
+	  lits[res++] = 0;
+	}
+      else
+	res += collect_full_clauses (lits + res, clause, i + 1, n);
+    }
+  return res;
+}
+
+static void
+test_add_clauses (void)
+{
+  const int m = tissat_big ? 16 : 10;
+
+  for (int n = 1; n < m; n++)
+    {
+      int clause[n + 1];
+      const size_t clauses = (size_t) 1 << n;
+      const size_t literals = clauses * n;
+      const size_t size = literals + clauses;
+      int *lits = malloc (size * sizeof *lits);
+      if (!lits)
+	FATAL ("out-of-memory allocating %zu literals", size);
+      size_t collected = collect_full_clauses (lits, clause, 1, n);
+      if (collected != size)
+	FATAL ("collected %zu literals but expected %zu", collected, size);
+      kissat *solver = kissat_init ();
+      kissat_reserve (solver, n);
+      kissat_reserve_clauses (solver, clauses, literals);
+      const size_t arena = CAPACITY_STACK (solver->arena);
+      const size_t half = size / 2;
+      kissat_add_clauses (solver, lits, half);
+      kissat_add_clauses (solver, lits + half, size - half);
+      if (arena != CAPACITY_STACK (solver->arena))
+	FATAL ("arena resized after reserving space for %zu clauses",
+	       clauses);
+      printf ("%d: arena %s clauses %s\n", n,
+	      kissat_format_bytes (&solver->format, arena * sizeof (ward)),
+	      kissat_format_count (&solver->format, clauses));
+      int res = kissat_solve (solver);
+      if (res != 20)
+	FATAL ("expected '20' but got '%d'", res);
+      kissat_release (solver);
+      free (lits);
+    }
+}
+
 void
 tissat_schedule_add (void)
 {
   SCHEDULE_FUNCTION (test_add);
+  SCHEDULE_FUNCTION (test_add_clauses);
 }
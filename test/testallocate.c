@@ -33,6 +33,7 @@ test_allocate_basic (void)
   for (unsigned i = 0; i < 24; i++)
     assert (p[1u << i] == 0x42424242);
   kissat_dealloc (solver, p, 1 << 22, 4 * sizeof *p);
+  assert (!solver->allocated);
 #ifdef METRICS
   assert (!solver->statistics.allocated_current);
   assert (solver->statistics.allocated_max == 1u << 30);
@@ -49,6 +50,79 @@ test_allocate_coverage (void)
   assert (!p);
 }
 
+static void
+test_allocate_limit (void)
+{
+  const int pigeons = 7, holes = pigeons - 1;
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  for (int p = 0; p < pigeons; p++)
+    {
+      for (int h = 1; h <= holes; h++)
+	kissat_add (solver, p * holes + h);
+      kissat_add (solver, 0);
+    }
+  for (int h = 1; h <= holes; h++)
+    for (int p = 0; p < pigeons; p++)
+      for (int q = p + 1; q < pigeons; q++)
+	{
+	  kissat_add (solver, -(p * holes + h));
+	  kissat_add (solver, -(q * holes + h));
+	  kissat_add (solver, 0);
+	}
+  kissat_set_memory_limit (solver, 0);
+  int res = kissat_solve (solver);
+  if (res)
+    FATAL ("memory limited solver returned '%d' but expected '0'", res);
+  if (!solver->statistics.reclaims)
+    FATAL ("memory limit hit without trying to reclaim memory");
+  kissat_set_memory_limit (solver, 1u << 12);
+  res = kissat_solve (solver);
+  if (res != 20)
+    FATAL ("solver returned '%d' but expected '20'", res);
+  kissat_release (solver);
+}
+
+static void
+test_allocate_tagged (void)
+{
+  DECLARE_AND_INIT_SOLVER (solver);
+  void *p;
+  ACCOUNT (walk, p = kissat_malloc (solver, 1000));
+  void *q = kissat_malloc (solver, 10);
+  assert (solver->memory.current[MEM_walk] == 1000);
+  assert (solver->memory.current[MEM_other] == 10);
+  ACCOUNT (walk, p = kissat_realloc (solver, p, 1000, 100));
+  assert (solver->memory.current[MEM_walk] == 100);
+  assert (solver->memory.peak[MEM_walk] == 1000);
+  ACCOUNT (walk, kissat_free (solver, p, 100));
+  kissat_free (solver, q, 10);
+  for (unsigned tag = 0; tag < MEM_TAGS; tag++)
+    assert (!solver->memory.current[tag]);
+  assert (!solver->memory.tag);
+}
+
+static void
+test_allocate_usage (void)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  for (int idx = 1; idx <= 100; idx++)
+    kissat_add (solver, idx), kissat_add (solver, -idx - 1),
+      kissat_add (solver, 0);
+  size_t peak;
+  const size_t variables =
+    kissat_memory_usage (solver, "variables", &peak);
+  if (!variables)
+    FATAL ("no memory accounted to variables");
+  if (peak < variables)
+    FATAL ("peak variables memory below current");
+  peak = 1;
+  if (kissat_memory_usage (solver, "unknown", &peak) || peak)
+    FATAL ("memory accounted to unknown subsystem");
+  kissat_release (solver);
+}
+
 #ifndef ASAN
 
 #include <setjmp.h>
@@ -107,6 +181,9 @@ tissat_schedule_allocate (void)
 {
   SCHEDULE_FUNCTION (test_allocate_basic);
   SCHEDULE_FUNCTION (test_allocate_coverage);
+  SCHEDULE_FUNCTION (test_allocate_limit);
+  SCHEDULE_FUNCTION (test_allocate_tagged);
+  SCHEDULE_FUNCTION (test_allocate_usage);
 #ifndef ASAN
   SCHEDULE_FUNCTION (test_allocate_error);
 #endif
@@ -23,7 +23,7 @@ test_arena_basic (void)
       printf ("iteration %d\n", i);
       (void) kissat_allocate_clause (solver, size);
     }
-  RELEASE_STACK (solver->arena);
+  kissat_release_arena (solver);
 #ifdef METRICS
   assert (!solver->statistics.allocated_current);
 #endif
@@ -48,7 +48,6 @@ test_arena_realloc (void)
       reference ref = kissat_allocate_clause (solver, size);
       clause *c = kissat_unchecked_dereference_clause (solver, ref);
       c->size = size;
-      c->shrunken = false;
       for (unsigned i = 0; i < size; i++)
 	c->lits[i] = 42;
 #ifndef QUIET
@@ -59,13 +58,15 @@ test_arena_realloc (void)
 #endif
     }
 #ifdef METRICS
-  assert (solver->statistics.allocated_current == n * bytes);
+  assert (solver->arena_mapped ||
+	  solver->statistics.allocated_current == n * bytes +
+	  CAPACITY_STACK (solver->colds) * sizeof (cold));
 #endif
   unsigned count = 0;
   for (all_clauses (c))
     count++;
   assert (count == n);
-  RELEASE_STACK (solver->arena);
+  kissat_release_arena (solver);
 #ifdef METRICS
   assert (!solver->statistics.allocated_current);
 #endif
@@ -81,7 +82,6 @@ test_arena_traverse (void)
       reference ref = kissat_allocate_clause (solver, size);
       clause *c = kissat_unchecked_dereference_clause (solver, ref);
       c->size = size;
-      c->shrunken = false;
       for (unsigned i = 0; i < size; i++)
 	c->lits[i] = size;
     }
@@ -90,12 +90,63 @@ test_arena_traverse (void)
     {
       found++;
       assert (c->size == size);
-      assert (!c->shrunken);
+      assert (!COLD (c)->shrunken);
       assert (c->lits[0] == size);
       size++;
     }
   assert (found == n);
-  RELEASE_STACK (solver->arena);
+  kissat_release_arena (solver);
+#ifdef METRICS
+  assert (!solver->statistics.allocated_current);
+#endif
+}
+
+static void
+test_arena_mapped (void)
+{
+  DECLARE_AND_INIT_SOLVER (solver);
+#ifndef NOPTIONS
+  solver->options.arenamap = 1;
+#endif
+  const unsigned size = (1u << 20) - 3;
+  reference first = kissat_allocate_clause (solver, size);
+  clause *c = kissat_unchecked_dereference_clause (solver, first);
+  c->size = size;
+  c->lits[0] = 42;
+  ward *begin = BEGIN_STACK (solver->arena);
+  bool mapped = false;
+  for (unsigned i = 0; i < 32; i++)
+    {
+      (void) kissat_allocate_clause (solver, size);
+      if (mapped)
+	{
+	  assert (solver->arena_mapped);
+	  assert (BEGIN_STACK (solver->arena) == begin);
+	}
+      else if (solver->arena_mapped)
+	{
+	  tissat_verbose ("arena mapped after %u clauses", i + 2);
+	  begin = BEGIN_STACK (solver->arena);
+	  mapped = true;
+	}
+      c = kissat_unchecked_dereference_clause (solver, first);
+      assert (c->size == size);
+      assert (c->lits[0] == 42);
+    }
+  if (mapped)
+    {
+      size_t peak;
+      const size_t bytes = SIZE_STACK (solver->arena) * sizeof (ward) +
+	CAPACITY_STACK (solver->colds) * sizeof (cold);
+      assert (kissat_memory_usage (solver, "arena", &peak) == bytes);
+      assert (peak >= bytes);
+    }
+  else
+    tissat_verbose ("arena not mapped");
+  SET_END_OF_STACK (solver->arena, BEGIN_STACK (solver->arena) + 1);
+  kissat_shrink_arena (solver);
+  kissat_release_arena (solver);
+  assert (!solver->arena_mapped);
 #ifdef METRICS
   assert (!solver->statistics.allocated_current);
 #endif
@@ -141,7 +192,7 @@ test_arena_fatal (void)
 			capacity, FORMAT_BYTES (capacity * sizeof (ward)));
 	assert (capacity == MAX_ARENA);
 	assert (size + 1 == MAX_ARENA);
-	kissat_allocate_clause (solver, 3);
+	kissat_allocate_clause (solver, sizeof (ward));
       }
       kissat_call_function_instead_of_abort (0);
       FATAL ("long jump not taken");
@@ -154,5 +205,6 @@ tissat_schedule_arena (void)
   SCHEDULE_FUNCTION (test_arena_basic);
   SCHEDULE_FUNCTION (test_arena_realloc);
   SCHEDULE_FUNCTION (test_arena_traverse);
+  SCHEDULE_FUNCTION (test_arena_mapped);
   SCHEDULE_FUNCTION (test_arena_fatal);
 }
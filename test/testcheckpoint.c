@@ -0,0 +1,167 @@
+#include "../src/file.h"
+#include "../src/parse.h"
+
+#include "test.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+static kissat *
+new_solver_parsing (const char *cnf)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  file file;
+  if (!kissat_open_to_read_file (&file, cnf))
+    FATAL ("could not read '%s'", cnf);
+  uint64_t lineno;
+  int max_var;
+  const char *error =
+    kissat_parse_dimacs (solver, RELAXED_PARSING, &file, &lineno, &max_var);
+  if (error)
+    FATAL ("unexpected parse error: %s", error);
+  kissat_close_file (&file);
+  return solver;
+}
+
+static kissat *
+new_solver_restoring (const char *path)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  if (!kissat_restore (solver, path))
+    FATAL ("could not restore checkpoint '%s'", path);
+  return solver;
+}
+
+static void
+test_checkpoint_interrupted (void)
+{
+  const char *path = "prime65537.checkpoint";
+  kissat *solver = new_solver_parsing ("../test/cnf/prime65537.cnf");
+  kissat_set_checkpoint (solver, path, 1e-9);
+  kissat_set_conflict_limit (solver, 1200);
+  int res = kissat_solve (solver);
+  if (res)
+    FATAL ("limited solver returned '%d' but expected '0'", res);
+  const uint64_t conflicts = solver->statistics.conflicts;
+  kissat_release (solver);
+  solver = new_solver_restoring (path);
+  const uint64_t restored = solver->statistics.conflicts;
+  if (!restored || restored > conflicts)
+    FATAL ("restored %" PRIu64 " conflicts out of %" PRIu64,
+	   restored, conflicts);
+  res = kissat_solve (solver);
+  if (res != 20)
+    FATAL ("restored solver returned '%d' but expected '20'", res);
+  tissat_verbose ("resumed after %" PRIu64 " conflicts", restored);
+  kissat_release (solver);
+}
+
+static void
+test_checkpoint_model (void)
+{
+  const char *path = "sqrt10201.checkpoint";
+  kissat *solver = new_solver_parsing ("../test/cnf/sqrt10201.cnf");
+  int res = kissat_solve (solver);
+  if (res != 10)
+    FATAL ("solver returned '%d' but expected '10'", res);
+  if (!kissat_checkpoint (solver, path))
+    FATAL ("could not write checkpoint '%s'", path);
+  kissat *restored = new_solver_restoring (path);
+  const int vars = SIZE_STACK (solver->import);
+  for (int idx = 1; idx < vars; idx++)
+    if (kissat_value (solver, idx) != kissat_value (restored, idx))
+      FATAL ("restored value of variable %d differs", idx);
+  res = kissat_solve (restored);
+  if (res != 10)
+    FATAL ("restored solver returned '%d' but expected '10'", res);
+  kissat_release (restored);
+  kissat_release (solver);
+}
+
+static void
+test_checkpoint_sweep (void)
+{
+  const char *path = "add64-sweep.checkpoint";
+  kissat *solver = new_solver_parsing ("../test/cnf/add64.cnf");
+  kissat_set_conflict_limit (solver, 1500);
+  int res = kissat_solve (solver);
+  if (res)
+    FATAL ("limited solver returned '%d' but expected '0'", res);
+  if (!kissat_checkpoint (solver, path))
+    FATAL ("could not write checkpoint '%s'", path);
+  kissat *restored = new_solver_restoring (path);
+  const size_t sweep = SIZE_STACK (solver->sweep);
+  if (!sweep)
+    tissat_verbose ("no variables remain to be swept");
+  if (SIZE_STACK (restored->sweep) != sweep ||
+      (sweep && memcmp (BEGIN_STACK (solver->sweep),
+			BEGIN_STACK (restored->sweep),
+			sweep * sizeof (unsigned))))
+    FATAL ("restored sweeping schedule differs");
+  kissat_release (solver);
+  res = kissat_solve (restored);
+  if (res != 20)
+    FATAL ("restored solver returned '%d' but expected '20'", res);
+  kissat_release (restored);
+}
+
+static void
+test_checkpoint_memory_limit (void)
+{
+  const char *path = "add64.checkpoint";
+  kissat *solver = new_solver_parsing ("../test/cnf/add64.cnf");
+  kissat_set_conflict_limit (solver, 10);
+  int res = kissat_solve (solver);
+  if (res)
+    FATAL ("limited solver returned '%d' but expected '0'", res);
+  if (!kissat_checkpoint (solver, path))
+    FATAL ("could not write checkpoint '%s'", path);
+  kissat_release (solver);
+  solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_memory_limit (solver, 1000);
+  const uint64_t memory = solver->limits.memory;
+  const uint64_t reclaim = solver->limits.reclaim.bytes;
+  if (!kissat_restore (solver, path))
+    FATAL ("could not restore checkpoint '%s'", path);
+  if (!solver->limited.memory)
+    FATAL ("memory limit lost after restoring");
+  if (solver->limits.memory != memory)
+    FATAL ("restored memory limit %" PRIu64 " but expected %" PRIu64,
+	   solver->limits.memory, memory);
+  if (solver->limits.reclaim.bytes != reclaim)
+    FATAL ("restored reclaim limit %" PRIu64 " but expected %" PRIu64,
+	   solver->limits.reclaim.bytes, reclaim);
+  res = kissat_solve (solver);
+  if (res != 20)
+    FATAL ("restored solver returned '%d' but expected '20'", res);
+  kissat_release (solver);
+}
+
+static void
+test_checkpoint_incompatible (void)
+{
+  const char *path = "incompatible.checkpoint";
+  FILE *file = fopen (path, "w");
+  if (!file)
+    FATAL ("could not write '%s'", path);
+  fputs ("kissat checkpoint", file);
+  fclose (file);
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  if (kissat_restore (solver, path))
+    FATAL ("restoring truncated checkpoint succeeded");
+  kissat_release (solver);
+}
+
+void
+tissat_schedule_checkpoint (void)
+{
+  SCHEDULE_FUNCTION (test_checkpoint_interrupted);
+  SCHEDULE_FUNCTION (test_checkpoint_model);
+  SCHEDULE_FUNCTION (test_checkpoint_sweep);
+  SCHEDULE_FUNCTION (test_checkpoint_memory_limit);
+  SCHEDULE_FUNCTION (test_checkpoint_incompatible);
+}
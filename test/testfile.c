@@ -1,6 +1,7 @@
 #include "../src/file.h"
 
 #include <inttypes.h>
+#include <stdlib.h>
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -97,6 +98,18 @@ do { \
 #undef WRITABLE
 }
 
+static bool
+can_decompress (const char *executable, const char *path)
+{
+#ifdef BUILTIN_DECOMPRESSION
+  if (kissat_decompressed_internally (path))
+    return true;
+#else
+  (void) path;
+#endif
+  return kissat_find_executable (executable);
+}
+
 #ifdef _POSIX_C_SOURCE
 
 static void
@@ -106,7 +119,7 @@ test_file_read_compressed (void)
 #define READ_COMPRESSED(EXPECTED,EXECUTABLE,PATH) \
 do { \
   file file; \
-  if (!kissat_find_executable (EXECUTABLE)) \
+  if (!can_decompress (EXECUTABLE, PATH)) \
     { \
       printf ("skipping '%s': could not find executable '%s'\n", \
               EXECUTABLE, PATH); \
@@ -152,6 +165,54 @@ do { \
   READ_COMPRESSED (true, "xz", "../test/file/uncompressed.xz");
 }
 
+#ifdef BUILTIN_DECOMPRESSION
+
+static void
+test_file_read_truncated (void)
+{
+#define READ_TRUNCATED(SRC,DST) \
+do { \
+  if (!kissat_decompressed_internally (DST)) \
+    { \
+      printf ("skipping '%s': not decompressed internally\n", DST); \
+      break; \
+    } \
+  const size_t size = kissat_file_size (SRC); \
+  unsigned char *buffer = malloc (size); \
+  if (!buffer) \
+    FATAL ("out-of-memory reading '%s'", SRC); \
+  FILE *src = fopen (SRC, "r"); \
+  if (!src) \
+    FATAL ("failed to open '%s'", SRC); \
+  if (fread (buffer, 1, size, src) != size) \
+    FATAL ("failed to read '%s'", SRC); \
+  fclose (src); \
+  FILE *dst = fopen (DST, "w"); \
+  if (!dst) \
+    FATAL ("failed to write '%s'", DST); \
+  fwrite (buffer, 1, size / 2, dst); \
+  fclose (dst); \
+  free (buffer); \
+  file file; \
+  if (!kissat_open_to_read_file (&file, DST)) \
+    FATAL ("failed to open truncated '%s'", DST); \
+  while (kissat_getc (&file) != EOF) \
+    ; \
+  const char *error = kissat_decompression_error (&file); \
+  kissat_close_file (&file); \
+  unlink (DST); \
+  if (!error) \
+    FATAL ("no error reading truncated '%s'", DST); \
+  printf ("reading truncated '%s' failed with '%s' as expected\n", \
+          DST, error); \
+} while (0)
+  READ_TRUNCATED ("../test/file/1.bz2", "truncated.bz2");
+  READ_TRUNCATED ("../test/file/2.gz", "truncated.gz");
+  READ_TRUNCATED ("../test/file/5.xz", "truncated.xz");
+}
+
+#endif
+
 #endif
 
 static void
@@ -252,5 +313,9 @@ tissat_schedule_file (void)
   SCHEDULE_FUNCTION (test_file_write_and_read_compressed);
   if (tissat_found_test_directory)
     SCHEDULE_FUNCTION (test_file_read_compressed);
+#ifdef BUILTIN_DECOMPRESSION
+  if (tissat_found_test_directory)
+    SCHEDULE_FUNCTION (test_file_read_truncated);
+#endif
 #endif
 }
@@ -0,0 +1,223 @@
+#include "../src/random.h"
+
+#include "test.h"
+
+static void
+test_incremental_assumptions (void)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_add (solver, -1), kissat_add (solver, 2), kissat_add (solver, 0);
+  kissat_add (solver, -2), kissat_add (solver, 3), kissat_add (solver, 0);
+  kissat_assume (solver, 1);
+  kissat_assume (solver, -3);
+  int res = kissat_solve (solver);
+  if (res != 20)
+    FATAL ("first call returned '%d' but expected '20'", res);
+  if (!kissat_failed (solver, 1))
+    FATAL ("assumption '1' not failed");
+  if (!kissat_failed (solver, -3))
+    FATAL ("assumption '-3' not failed");
+  if (kissat_failed (solver, -1) || kissat_failed (solver, 2))
+    FATAL ("unexpected failed literal");
+  kissat_assume (solver, 1);
+  res = kissat_solve (solver);
+  if (res != 10)
+    FATAL ("second call returned '%d' but expected '10'", res);
+  if (kissat_value (solver, 3) != 3)
+    FATAL ("expected '3' to be assigned to true");
+  if (kissat_failed (solver, 1))
+    FATAL ("assumption '1' still failed");
+  kissat_add (solver, -3), kissat_add (solver, 0);
+  res = kissat_solve (solver);
+  if (res != 10)
+    FATAL ("third call returned '%d' but expected '10'", res);
+  if (kissat_value (solver, 1) != -1)
+    FATAL ("expected '1' to be assigned to false");
+  kissat_assume (solver, 1);
+  res = kissat_solve (solver);
+  if (res != 20)
+    FATAL ("fourth call returned '%d' but expected '20'", res);
+  if (!kissat_failed (solver, 1))
+    FATAL ("root-level falsified assumption '1' not failed");
+  kissat_release (solver);
+}
+
+static void
+test_incremental_enumerate (void)
+{
+  const int vars = 8;
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  for (int idx = 1; idx <= vars; idx++)
+    kissat_add (solver, idx);
+  kissat_add (solver, 0);
+  unsigned models = 0;
+  while (kissat_solve (solver) == 10)
+    {
+      int blocking[vars];
+      for (int idx = 1; idx <= vars; idx++)
+	blocking[idx - 1] = -kissat_value (solver, idx);
+      for (int i = 0; i < vars; i++)
+	kissat_add (solver, blocking[i]);
+      kissat_add (solver, 0);
+      models++;
+    }
+  const unsigned expected = (1u << vars) - 1;
+  if (models != expected)
+    FATAL ("enumerated %u models but expected %u", models, expected);
+  tissat_verbose ("enumerated %u models as expected", models);
+  kissat_release (solver);
+}
+
+static void
+test_incremental_values (void)
+{
+  const int vars = 100;
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  generator random = 7;
+  for (int idx = 1; idx < vars; idx++)
+    {
+      const int lit = kissat_pick_bool (&random) ? -idx : idx;
+      kissat_add (solver, lit), kissat_add (solver, idx + 1);
+      kissat_add (solver, 0);
+    }
+  kissat_add (solver, 1), kissat_add (solver, vars / 2), kissat_add (solver, 0);
+  const int res = kissat_solve (solver);
+  if (res != 10)
+    FATAL ("solver returned '%d' but expected '10'", res);
+  const int size = vars + 10;
+  int values[size];
+  kissat_values (solver, values, size);
+  for (int idx = 1; idx <= size; idx++)
+    if (values[idx - 1] != kissat_value (solver, idx))
+      FATAL ("bulk value of variable %d differs", idx);
+  kissat_release (solver);
+}
+
+#ifndef NOPTIONS
+
+#define RANDOM_VARS 40
+#define MAX_RANDOM_CLAUSES 200
+#define ASSUMPTIONS 3
+
+static int clauses[MAX_RANDOM_CLAUSES][3];
+static unsigned size_clauses;
+
+static void
+add_random_clause (kissat * solver, generator * random)
+{
+  assert (size_clauses < MAX_RANDOM_CLAUSES);
+  int *clause = clauses[size_clauses++];
+  for (unsigned i = 0; i < 3; i++)
+    {
+      int idx;
+      unsigned j;
+      do
+	{
+	  idx = (int) kissat_pick_random (random, 1, RANDOM_VARS + 1);
+	  for (j = 0; j < i && ABS (clause[j]) != idx; j++)
+	    ;
+	}
+      while (j < i);
+      clause[i] = kissat_pick_bool (random) ? -idx : idx;
+      kissat_add (solver, clause[i]);
+    }
+  kissat_add (solver, 0);
+}
+
+static void
+check_model (kissat * solver, unsigned size, const int *assumptions)
+{
+  for (unsigned i = 0; i < size_clauses; i++)
+    {
+      const int *clause = clauses[i];
+      unsigned j = 0;
+      while (j < 3 && kissat_value (solver, clause[j]) != clause[j])
+	j++;
+      if (j == 3)
+	FATAL ("clause %u unsatisfied", i);
+    }
+  for (unsigned i = 0; i < size; i++)
+    {
+      const int lit = assumptions[i];
+      if (kissat_value (solver, lit) != lit)
+	FATAL ("assumption '%d' not satisfied", lit);
+    }
+}
+
+static void
+check_core (kissat * solver, unsigned size, const int *assumptions)
+{
+  kissat *checker = kissat_init ();
+  tissat_init_solver (checker);
+  for (unsigned i = 0; i < size_clauses; i++)
+    {
+      for (unsigned j = 0; j < 3; j++)
+	kissat_add (checker, clauses[i][j]);
+      kissat_add (checker, 0);
+    }
+  for (unsigned i = 0; i < size; i++)
+    {
+      const int lit = assumptions[i];
+      if (!kissat_failed (solver, lit))
+	continue;
+      kissat_add (checker, lit);
+      kissat_add (checker, 0);
+    }
+  const int res = kissat_solve (checker);
+  if (res != 20)
+    FATAL ("failed assumptions are not unsatisfiable");
+  kissat_release (checker);
+}
+
+static void
+test_incremental_restore (void)
+{
+  generator random = 42;
+  size_clauses = 0;
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_option (solver, "eliminateinit", 0);
+  while (size_clauses < 3 * RANDOM_VARS)
+    add_random_clause (solver, &random);
+  unsigned sat = 0, unsat = 0;
+  for (unsigned round = 0; round < 40; round++)
+    {
+      if (round && !(round % 4) && size_clauses < MAX_RANDOM_CLAUSES)
+	add_random_clause (solver, &random);
+      int assumptions[ASSUMPTIONS];
+      for (unsigned i = 0; i < ASSUMPTIONS; i++)
+	{
+	  int lit = (int) kissat_pick_random (&random, 1, RANDOM_VARS + 1);
+	  if (kissat_pick_bool (&random))
+	    lit = -lit;
+	  assumptions[i] = lit;
+	  kissat_assume (solver, lit);
+	}
+      const int res = kissat_solve (solver);
+      if (res == 10)
+	check_model (solver, ASSUMPTIONS, assumptions), sat++;
+      else if (res == 20)
+	check_core (solver, ASSUMPTIONS, assumptions), unsat++;
+      else
+	FATAL ("unexpected result '%d'", res);
+    }
+  tissat_verbose ("checked %u satisfiable and %u unsatisfiable calls",
+		  sat, unsat);
+  kissat_release (solver);
+}
+
+#endif
+
+void
+tissat_schedule_incremental (void)
+{
+  SCHEDULE_FUNCTION (test_incremental_assumptions);
+  SCHEDULE_FUNCTION (test_incremental_enumerate);
+  SCHEDULE_FUNCTION (test_incremental_values);
+#ifndef NOPTIONS
+  SCHEDULE_FUNCTION (test_incremental_restore);
+#endif
+}
@@ -90,6 +90,7 @@ do { \
   CHECKNAME ("--conflicts=0", "conflicts", "0");
   CHECKNAME ("--conflicts=1000", "conflicts", "1000");
   CHECKNAME ("--decisions=2^20", "decisions", "2^20");
+  CHECKNAME ("--memlimit=1024", "memlimit", "1024");
 
 #undef CHECKNAME
 
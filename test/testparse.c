@@ -2,9 +2,44 @@
 #include "../src/parse.h"
 
 #include <inttypes.h>
+#include <unistd.h>
 
 #include "test.h"
 
+static const char *
+parse_file (bool map, unsigned threads, strictness strict, const char *path,
+	    uint64_t * lineno_ptr, int *max_var_ptr)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+#ifndef NOPTIONS
+  kissat_set_option (solver, "parsethreads", threads);
+#else
+  (void) threads;
+#endif
+  file file;
+  if (map)
+    {
+      if (!kissat_open_to_read_file (&file, path))
+	FATAL ("could not open '%s' for reading", path);
+    }
+  else
+    {
+      FILE *stream = fopen (path, "r");
+      if (!stream)
+	FATAL ("could not open '%s' for reading", path);
+      kissat_read_already_open_file (&file, stream, path);
+    }
+  const char *error =
+    kissat_parse_dimacs (solver, strict, &file, lineno_ptr, max_var_ptr);
+  FILE *stream = file.file;
+  kissat_close_file (&file);
+  if (!map)
+    fclose (stream);
+  kissat_release (solver);
+  return error;
+}
+
 static bool
 test_parse (bool expect_parse_error, unsigned strict, const char *path)
 {
@@ -24,15 +59,9 @@ test_parse (bool expect_parse_error, unsigned strict, const char *path)
     }
   tissat_verbose ("Parsing %svalid '%s' in '%s' mode.",
 		  expect_parse_error ? "in" : "", path, type);
-  kissat *solver = kissat_init ();
-  tissat_init_solver (solver);
-  file file;
-  if (!kissat_open_to_read_file (&file, path))
-    FATAL ("could not open '%s' for reading", path);
   uint64_t lineno;
   int max_var;
-  const char *error =
-    kissat_parse_dimacs (solver, strict, &file, &lineno, &max_var);
+  const char *error = parse_file (true, 1, strict, path, &lineno, &max_var);
   if (expect_parse_error)
     {
       if (!error)
@@ -45,8 +74,23 @@ test_parse (bool expect_parse_error, unsigned strict, const char *path)
 	     type, path, lineno, error);
       tissat_verbose ("found maximum variable '%d' in '%s'", max_var, path);
     }
-  kissat_close_file (&file);
-  kissat_release (solver);
+  for (unsigned mode = 0; mode < 2; mode++)
+    {
+      const bool map = mode;
+      const unsigned threads = map ? 4 : 1;
+      const char *how = map ? "mapped with four threads" : "as stream";
+      uint64_t other_lineno;
+      int other_max_var;
+      const char *other_error = parse_file (map, threads, strict, path,
+					    &other_lineno, &other_max_var);
+      if ((error != 0) != (other_error != 0) ||
+	  (error && strcmp (error, other_error)))
+	FATAL ("%s parsing '%s' mapped and %s differs", type, path, how);
+      if (error && lineno != other_lineno)
+	FATAL ("%s parsing '%s' mapped in line %" PRIu64
+	       " but %s in line %" PRIu64, type, path,
+	       lineno, how, other_lineno);
+    }
   return false;
 }
 
@@ -156,6 +200,82 @@ do {  \
 #undef PARSE
 }
 
+static void
+convert_to_binary (const char *src, const char *dst, size_t truncate)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  file input, output;
+  if (!kissat_open_to_read_file (&input, src))
+    FATAL ("could not open '%s' for reading", src);
+  if (!kissat_open_to_write_file (&output, dst))
+    FATAL ("could not open '%s' for writing", dst);
+  uint64_t lineno;
+  int max_var;
+  const char *error =
+    kissat_write_binary_cnf (solver, NORMAL_PARSING, &input, &output,
+			     &lineno, &max_var);
+  kissat_close_file (&input);
+  kissat_close_file (&output);
+  kissat_release (solver);
+  if (error)
+    FATAL ("converting '%s' failed: %s:%" PRIu64 ": %s",
+	   src, src, lineno, error);
+  if (truncate && truncate < output.bytes)
+    {
+      FILE *file = fopen (dst, "r+");
+      if (!file || ftruncate (fileno (file), output.bytes - truncate))
+	FATAL ("could not truncate '%s'", dst);
+      fclose (file);
+    }
+}
+
+static bool
+same_content (const char *a, const char *b)
+{
+  FILE *f = fopen (a, "r");
+  FILE *g = fopen (b, "r");
+  if (!f || !g)
+    FATAL ("could not open '%s' and '%s' for reading", a, b);
+  int ch;
+  bool res = true;
+  while (res && (ch = getc (f)) != EOF)
+    res = (getc (g) == ch);
+  if (res)
+    res = (getc (g) == EOF);
+  fclose (f);
+  fclose (g);
+  return res;
+}
+
+static void
+test_parse_binary (void)
+{
+#define BINARY(NAME) \
+do { \
+  const char *cnf = "../test/cnf/" #NAME ".cnf"; \
+  const char *binary = "binary-" #NAME ".bcnf"; \
+  const char *copy = "binary-" #NAME "-copy.bcnf"; \
+  const char *truncated = "binary-" #NAME "-truncated.bcnf"; \
+  convert_to_binary (cnf, binary, 0); \
+  convert_to_binary (binary, copy, 0); \
+  if (!same_content (binary, copy)) \
+    FATAL ("converting '%s' again yields different '%s'", binary, copy); \
+  convert_to_binary (cnf, truncated, 1); \
+  for (strictness strict = RELAXED_PARSING; \
+       strict <= PEDANTIC_PARSING; strict++) \
+    { \
+      test_parse (false, strict, binary); \
+      test_parse (true, strict, truncated); \
+    } \
+  tissat_call_application (20, binary); \
+} while (0)
+  BINARY (add8);
+  BINARY (ph4);
+  BINARY (unit1);
+#undef BINARY
+}
+
 void
 tissat_schedule_parse (void)
 {
@@ -163,4 +283,6 @@ tissat_schedule_parse (void)
     SCHEDULE_FUNCTION (test_parse_errors);
   if (tissat_found_test_directory)
     SCHEDULE_FUNCTION (test_parse_coverage);
+  if (tissat_found_test_directory)
+    SCHEDULE_FUNCTION (test_parse_binary);
 }
@@ -0,0 +1,206 @@
+#include "../src/file.h"
+#include "../src/parse.h"
+
+#include "test.h"
+
+#include <inttypes.h>
+
+static void
+add_pigeon_hole (kissat * solver, int pigeons)
+{
+  const int holes = pigeons - 1;
+  for (int p = 0; p < pigeons; p++)
+    {
+      for (int h = 1; h <= holes; h++)
+	kissat_add (solver, p * holes + h);
+      kissat_add (solver, 0);
+    }
+  for (int h = 1; h <= holes; h++)
+    for (int p = 0; p < pigeons; p++)
+      for (int q = p + 1; q < pigeons; q++)
+	{
+	  kissat_add (solver, -(p * holes + h));
+	  kissat_add (solver, -(q * holes + h));
+	  kissat_add (solver, 0);
+	}
+}
+
+static void
+test_portfolio_unsat (void)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_threads (solver, 4);
+  add_pigeon_hole (solver, 6);
+  const int res = kissat_solve (solver);
+  if (res != 20)
+    FATAL ("portfolio returned '%d' but expected '20'", res);
+  if (!solver->portfolio.winner)
+    FATAL ("no winner after portfolio solving");
+  kissat_release (solver);
+}
+
+static void
+parse_portfolio_formula (kissat * solver, const char *path)
+{
+  file file;
+  if (!kissat_open_to_read_file (&file, path))
+    FATAL ("could not read '%s'", path);
+  uint64_t lineno;
+  int max_var;
+  const char *error =
+    kissat_parse_dimacs (solver, RELAXED_PARSING, &file, &lineno, &max_var);
+  if (error)
+    FATAL ("unexpected parse error: %s", error);
+  kissat_close_file (&file);
+  if (solver->vars)
+    FATAL ("portfolio solver imported variables");
+}
+
+static void
+check_portfolio_model (kissat * solver)
+{
+  const ints *formula = &solver->portfolio.formula;
+  bool satisfied = false;
+  for (all_stack (int, lit, *formula))
+    if (!lit)
+      {
+	if (!satisfied)
+	  FATAL ("clause unsatisfied by portfolio model");
+	satisfied = false;
+      }
+    else if (kissat_value (solver, lit) == lit)
+      satisfied = true;
+  tissat_verbose ("checked model of %zu clauses",
+		  solver->portfolio.clauses);
+}
+
+static void
+test_portfolio_sat (void)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_threads (solver, 3);
+  parse_portfolio_formula (solver, "../test/cnf/sqrt10201.cnf");
+  const int res = kissat_solve (solver);
+  if (res != 10)
+    FATAL ("portfolio returned '%d' but expected '10'", res);
+  check_portfolio_model (solver);
+  kissat_release (solver);
+}
+
+static void
+test_portfolio_assumptions (void)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_threads (solver, 2);
+  kissat_add (solver, -1), kissat_add (solver, 2), kissat_add (solver, 0);
+  kissat_add (solver, -2), kissat_add (solver, 3), kissat_add (solver, 0);
+  kissat_assume (solver, 1);
+  kissat_assume (solver, -3);
+  int res = kissat_solve (solver);
+  if (res != 20)
+    FATAL ("first call returned '%d' but expected '20'", res);
+  if (!kissat_failed (solver, 1) || !kissat_failed (solver, -3))
+    FATAL ("assumptions not failed");
+  kissat_assume (solver, 1);
+  res = kissat_solve (solver);
+  if (res != 10)
+    FATAL ("second call returned '%d' but expected '10'", res);
+  if (kissat_value (solver, 3) != 3)
+    FATAL ("expected '3' to be assigned to true");
+  kissat_release (solver);
+}
+
+static void
+test_portfolio_limited (void)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_threads (solver, 2);
+  add_pigeon_hole (solver, 9);
+  kissat_set_conflict_limit (solver, 100);
+  int res = kissat_solve (solver);
+  if (res)
+    FATAL ("limited portfolio returned '%d' but expected '0'", res);
+  if (solver->limited.conflicts)
+    FATAL ("conflict limit not reset");
+  kissat_release (solver);
+}
+
+static void
+test_portfolio_sharing (void)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_threads (solver, 2);
+  add_pigeon_hole (solver, 7);
+  const int res = kissat_solve (solver);
+  if (res != 20)
+    FATAL ("sharing portfolio returned '%d' but expected '20'", res);
+  const statistics *statistics = &solver->portfolio.winner->statistics;
+  if (!statistics->shared_exported && !statistics->shared_received)
+    FATAL ("no clauses shared");
+  tissat_verbose ("exported %" PRIu64 " received %" PRIu64
+		  " imported %" PRIu64 " clauses",
+		  statistics->shared_exported, statistics->shared_received,
+		  statistics->shared_imported);
+  kissat_release (solver);
+}
+
+#ifndef NOPTIONS
+
+static void
+test_portfolio_cubes_unsat (void)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_threads (solver, 3);
+  kissat_set_option (solver, "cubes", 3);
+  kissat_set_option (solver, "cubeconflicts", 20);
+  add_pigeon_hole (solver, 7);
+  const int res = kissat_solve (solver);
+  if (res != 20)
+    FATAL ("cube-and-conquer returned '%d' but expected '20'", res);
+  const conquereds *cubes = &solver->portfolio.cubes;
+  if (EMPTY_STACK (*cubes))
+    FATAL ("no cubes solved");
+  for (all_stack (conquered, conquered, *cubes))
+    if (conquered.res == 10)
+      FATAL ("satisfiable cube %u", conquered.id);
+  tissat_verbose ("solved %zu cubes", SIZE_STACK (*cubes));
+  kissat_release (solver);
+}
+
+static void
+test_portfolio_cubes_sat (void)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_threads (solver, 2);
+  kissat_set_option (solver, "cubes", 4);
+  kissat_set_option (solver, "cubeconflicts", 10);
+  parse_portfolio_formula (solver, "../test/cnf/prime2209.cnf");
+  const int res = kissat_solve (solver);
+  if (res != 10)
+    FATAL ("cube-and-conquer returned '%d' but expected '10'", res);
+  check_portfolio_model (solver);
+  kissat_release (solver);
+}
+
+#endif
+
+void
+tissat_schedule_portfolio (void)
+{
+  SCHEDULE_FUNCTION (test_portfolio_unsat);
+  SCHEDULE_FUNCTION (test_portfolio_sat);
+  SCHEDULE_FUNCTION (test_portfolio_assumptions);
+  SCHEDULE_FUNCTION (test_portfolio_limited);
+  SCHEDULE_FUNCTION (test_portfolio_sharing);
+#ifndef NOPTIONS
+  SCHEDULE_FUNCTION (test_portfolio_cubes_unsat);
+  SCHEDULE_FUNCTION (test_portfolio_cubes_sat);
+#endif
+}
@@ -0,0 +1,286 @@
+#if !defined(NPROOFS) && !defined(NOPTIONS)
+
+#include "../src/file.h"
+#include "../src/parse.h"
+#include "../src/proof.h"
+
+#include "test.h"
+
+#include <inttypes.h>
+
+static void
+write_proof (const char *cnf, const char *path,
+	     bool binary, bool frat, int thread)
+{
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_option (solver, "proofthread", thread);
+  kissat_set_option (solver, "proofbuffer", 1);
+  file proof_file;
+  if (!kissat_open_to_write_file (&proof_file, path))
+    FATAL ("could not write '%s'", path);
+  kissat_init_proof (solver, &proof_file, binary, frat);
+  file file;
+  if (!kissat_open_to_read_file (&file, cnf))
+    FATAL ("could not read '%s'", cnf);
+  uint64_t lineno;
+  int max_var;
+  const char *error =
+    kissat_parse_dimacs (solver, RELAXED_PARSING, &file, &lineno, &max_var);
+  if (error)
+    FATAL ("unexpected parse error: %s", error);
+  kissat_close_file (&file);
+  const int res = kissat_solve (solver);
+  if (res != 20)
+    FATAL ("solver returned '%d' but expected '20'", res);
+  kissat_release_proof (solver);
+  kissat_close_file (&proof_file);
+  kissat_release (solver);
+}
+
+static void
+compare_proofs (const char *a, const char *b)
+{
+  FILE *f = fopen (a, "r");
+  FILE *g = fopen (b, "r");
+  if (!f || !g)
+    FATAL ("could not read proofs '%s' and '%s'", a, b);
+  size_t bytes = 0;
+  int ch;
+  while ((ch = getc (f)) == getc (g) && ch != EOF)
+    bytes++;
+  if (ch != EOF)
+    FATAL ("proofs '%s' and '%s' differ at byte %zu", a, b, bytes);
+  fclose (f);
+  fclose (g);
+  tissat_verbose ("proofs '%s' and '%s' identical (%zu bytes)", a, b, bytes);
+}
+
+static void
+test_proof_thread (const char *name, bool binary)
+{
+  char cnf[64], direct[64], threaded[64];
+  const char *type = binary ? "binary" : "ascii";
+  sprintf (cnf, "../test/cnf/%s.cnf", name);
+  sprintf (direct, "%s.%s.direct.proof", name, type);
+  sprintf (threaded, "%s.%s.threaded.proof", name, type);
+  write_proof (cnf, direct, binary, false, 0);
+  write_proof (cnf, threaded, binary, false, 1);
+  compare_proofs (direct, threaded);
+}
+
+static void
+test_proof_thread_binary (void)
+{
+  test_proof_thread ("prime65537", true);
+}
+
+static void
+test_proof_thread_ascii (void)
+{
+  test_proof_thread ("prime65537", false);
+}
+
+// A minimal FRAT checker.  It only checks that identifiers are unique,
+// that deleted and finalized clauses match live clauses, that all hinted
+// lemmas follow by unit propagation over their hints, and that the empty
+// clause is derived.  Lemmas without hints are not checked.
+
+#define MAX_FRAT_VARS 1024
+#define MAX_FRAT_SIZE 4096
+
+typedef struct frat_clause frat_clause;
+
+struct frat_clause
+{
+  bool live;
+  unsigned size;
+  int *lits;
+};
+
+static frat_clause *frat_clauses;
+static uint64_t size_frat_clauses;
+
+static unsigned
+read_frat_numbers (FILE * file, int64_t * numbers)
+{
+  unsigned size = 0;
+  int64_t number;
+  for (;;)
+    {
+      if (fscanf (file, "%" SCNd64, &number) != 1)
+	FATAL ("failed to read FRAT number");
+      if (!number)
+	return size;
+      if (size == MAX_FRAT_SIZE)
+	FATAL ("too many FRAT numbers");
+      numbers[size++] = number;
+    }
+}
+
+static frat_clause *
+find_frat_clause (uint64_t id)
+{
+  if (!id || id >= size_frat_clauses)
+    FATAL ("invalid FRAT clause identifier %" PRIu64, id);
+  return frat_clauses + id;
+}
+
+static void
+check_frat_match (frat_clause * c, unsigned size, const int64_t * lits,
+		  uint64_t id)
+{
+  if (!c->live)
+    FATAL ("FRAT clause %" PRIu64 " not live", id);
+  if (c->size != size)
+    FATAL ("FRAT clause %" PRIu64 " size mismatch", id);
+  for (unsigned i = 0; i < size; i++)
+    {
+      unsigned j = 0;
+      while (j < size && c->lits[j] != lits[i])
+	j++;
+      if (j == size)
+	FATAL ("FRAT clause %" PRIu64 " literal mismatch", id);
+    }
+}
+
+static void
+check_frat_hints (signed char *values, unsigned size, const int64_t * lits,
+		  unsigned hints, const int64_t * ids, uint64_t id)
+{
+  memset (values, 0, 2 * MAX_FRAT_VARS);
+  signed char *value = values + MAX_FRAT_VARS;
+  for (unsigned i = 0; i < size; i++)
+    value[lits[i]] = -1, value[-lits[i]] = 1;
+  for (unsigned i = 0; i < hints; i++)
+    {
+      const frat_clause *const c = find_frat_clause (ids[i]);
+      if (!c->live)
+	FATAL ("hint %" PRId64 " of lemma %" PRIu64 " not live", ids[i], id);
+      int unit = 0;
+      unsigned unassigned = 0;
+      for (unsigned j = 0; j < c->size; j++)
+	{
+	  const int lit = c->lits[j];
+	  if (value[lit] > 0)
+	    FATAL ("hint %" PRId64 " of lemma %" PRIu64 " satisfied",
+		   ids[i], id);
+	  if (!value[lit])
+	    unit = lit, unassigned++;
+	}
+      if (!unassigned)
+	return;
+      if (unassigned > 1)
+	FATAL ("hint %" PRId64 " of lemma %" PRIu64 " not unit", ids[i], id);
+      value[unit] = 1, value[-unit] = -1;
+    }
+  FATAL ("hints of lemma %" PRIu64 " do not yield a conflict", id);
+}
+
+static void
+check_frat_proof (const char *path)
+{
+  FILE *file = fopen (path, "r");
+  if (!file)
+    FATAL ("could not read FRAT proof '%s'", path);
+  static int64_t lits[MAX_FRAT_SIZE], hints[MAX_FRAT_SIZE];
+  static signed char values[2 * MAX_FRAT_VARS];
+  uint64_t lemmas = 0, hinted = 0, live = 0;
+  bool empty = false;
+  char type;
+  while (fscanf (file, " %c", &type) == 1)
+    {
+      uint64_t id;
+      if (fscanf (file, "%" SCNu64, &id) != 1)
+	FATAL ("failed to read FRAT clause identifier");
+      const unsigned size = read_frat_numbers (file, lits);
+      for (unsigned i = 0; i < size; i++)
+	if (lits[i] <= -MAX_FRAT_VARS || lits[i] >= MAX_FRAT_VARS)
+	  FATAL ("FRAT literal %" PRId64 " out of range", lits[i]);
+      if (type == 'o' || type == 'a')
+	{
+	  if (type == 'a')
+	    {
+	      lemmas++;
+	      int ch;
+	      while ((ch = getc (file)) == ' ')
+		;
+	      if (ch == 'l')
+		{
+		  const unsigned size_hints = read_frat_numbers (file, hints);
+		  check_frat_hints (values, size, lits, size_hints, hints, id);
+		  hinted++;
+		}
+	      else
+		ungetc (ch, file);
+	    }
+	  if (id >= size_frat_clauses)
+	    {
+	      const uint64_t new_size = 2 * id;
+	      frat_clauses = realloc (frat_clauses,
+				      new_size * sizeof *frat_clauses);
+	      memset (frat_clauses + size_frat_clauses, 0,
+		      (new_size - size_frat_clauses) * sizeof *frat_clauses);
+	      size_frat_clauses = new_size;
+	    }
+	  frat_clause *c = frat_clauses + id;
+	  if (c->live || c->lits)
+	    FATAL ("FRAT clause identifier %" PRIu64 " reused", id);
+	  c->live = true;
+	  c->size = size;
+	  c->lits = malloc ((size + 1) * sizeof *c->lits);
+	  for (unsigned i = 0; i < size; i++)
+	    c->lits[i] = lits[i];
+	  if (!size)
+	    empty = true;
+	  live++;
+	}
+      else if (type == 'd' || type == 'f')
+	{
+	  frat_clause *c = find_frat_clause (id);
+	  check_frat_match (c, size, lits, id);
+	  c->live = false;
+	  live--;
+	}
+      else
+	FATAL ("unexpected FRAT line type '%c'", type);
+    }
+  fclose (file);
+  for (uint64_t id = 0; id < size_frat_clauses; id++)
+    free (frat_clauses[id].lits);
+  free (frat_clauses);
+  frat_clauses = 0;
+  size_frat_clauses = 0;
+  if (live)
+    FATAL ("%" PRIu64 " FRAT clauses not finalized", live);
+  if (!empty)
+    FATAL ("FRAT proof misses empty clause");
+  if (!hinted)
+    FATAL ("no FRAT lemma hinted");
+  tissat_verbose ("checked %" PRIu64 " hinted out of %" PRIu64
+		  " FRAT lemmas", hinted, lemmas);
+}
+
+static void
+test_proof_frat (void)
+{
+  write_proof ("../test/cnf/ph6.cnf", "ph6.frat", false, true, 1);
+  check_frat_proof ("ph6.frat");
+}
+
+void
+tissat_schedule_proof (void)
+{
+  SCHEDULE_FUNCTION (test_proof_thread_binary);
+  SCHEDULE_FUNCTION (test_proof_thread_ascii);
+  SCHEDULE_FUNCTION (test_proof_frat);
+}
+
+#else
+
+void
+tissat_schedule_proof (void)
+{
+}
+
+#endif
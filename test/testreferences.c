@@ -241,7 +241,7 @@ do { \
   assert (refs[1]);
 
   RELEASE_WATCHES (*watches);
-  RELEASE_STACK (solver->vectors.stack);
+  ACCOUNT (vectors, RELEASE_STACK (solver->vectors.stack));
 
   solver->watches = 0;
   solver->size = 0;
@@ -254,9 +254,83 @@ do { \
 #undef SETUP_FOUND_AND_CLAUSES
 #undef PUSH_WATCHS
 
+static void
+test_references_ternary (void)
+{
+  DECLARE_AND_INIT_SOLVER (solver);
+
+  solver->size = solver->vars = 1;
+
+  vector watches[2];
+  memset (watches, 0, sizeof watches);
+  solver->watches = watches;
+
+  kissat_push_blocking_watch (solver, watches, 1, 0);
+  kissat_push_ternary_watch (solver, watches, 2, 3, 1);
+  kissat_push_blocking_watch (solver, watches, 4, 2);
+  kissat_push_binary_watch (solver, watches, false, 5);
+
+  assert (SIZE_WATCHES (*watches) == 8);
+
+  unsigned count = 0;
+  {
+    reference ref;
+    for (all_binary_blocking_watch_ref (watch, ref, *watches))
+      {
+	if (!count)
+	  {
+	    assert (watch.type.binary);
+	    assert (watch.binary.lit == 5);
+	    assert (ref == INVALID_REF);
+	  }
+	else
+	  {
+	    assert (!watch.type.binary);
+	    assert (ref == count - 1);
+	    assert (watch.type.ternary == (ref == 1));
+	    assert (watch.blocking.lit == (ref == 2 ? 4 : ref + 1));
+	    if (watch.type.ternary)
+	      assert (watch_PTR[2].blocking.lit == 3);
+	  }
+	count++;
+      }
+  }
+  assert (count == 4);
+
+  kissat_remove_blocking_watch (solver, watches, 1);
+  assert (SIZE_WATCHES (*watches) == 5);
+
+  count = 0;
+  {
+    reference ref;
+    for (all_binary_blocking_watch_ref (watch, ref, *watches))
+      {
+	assert (!watch.type.ternary);
+	assert (ref != 1);
+	count++;
+      }
+  }
+  assert (count == 3);
+
+  kissat_remove_blocking_watch (solver, watches, 0);
+  kissat_remove_blocking_watch (solver, watches, 2);
+  assert (SIZE_WATCHES (*watches) == 1);
+
+  RELEASE_WATCHES (*watches);
+  ACCOUNT (vectors, RELEASE_STACK (solver->vectors.stack));
+
+  solver->watches = 0;
+  solver->size = 0;
+
+#ifdef METRICS
+  assert (!solver->statistics.allocated_current);
+#endif
+}
+
 void
 tissat_schedule_references (void)
 {
   SCHEDULE_FUNCTION (test_references_layout);
   SCHEDULE_FUNCTION (test_references_enlarge);
+  SCHEDULE_FUNCTION (test_references_ternary);
 }
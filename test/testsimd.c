@@ -0,0 +1,51 @@
+#include "../src/random.h"
+#include "../src/simd.h"
+
+#include "test.h"
+
+#define MAX_LITS 64
+#define MAX_SIZE 100
+
+static void
+test_simd_search (void)
+{
+  const unsigned supported = kissat_simd_supported ();
+  tissat_verbose ("checking '%s' replacement search",
+		  kissat_simd_name (supported));
+  generator random = 42;
+  value values[MAX_LITS];
+  unsigned lits[MAX_SIZE];
+  unsigned checked = 0;
+  for (unsigned round = 0; round < 10000; round++)
+    {
+      const unsigned size_values = kissat_pick_random (&random, 1, MAX_LITS);
+      for (unsigned i = 0; i < size_values; i++)
+	{
+	  const unsigned choice = kissat_pick_random (&random, 0, 8);
+	  values[i] = choice ? -1 : (kissat_pick_bool (&random) ? 1 : 0);
+	}
+      const unsigned size = kissat_pick_random (&random, 0, MAX_SIZE);
+      for (unsigned i = 0; i < size; i++)
+	lits[i] = kissat_pick_random (&random, 0, size_values);
+      unsigned *expected = lits;
+      while (expected != lits + size && values[*expected] < 0)
+	expected++;
+      for (unsigned simd = SIMD_SCALAR; simd <= supported; simd++)
+	{
+	  const unsigned *found =
+	    kissat_simd_search (simd, values, size_values, lits, lits + size);
+	  if (found != expected)
+	    FATAL ("'%s' search found position %zu instead of %zu",
+		   kissat_simd_name (simd),
+		   (size_t) (found - lits), (size_t) (expected - lits));
+	  checked++;
+	}
+    }
+  tissat_verbose ("checked %u searches", checked);
+}
+
+void
+tissat_schedule_simd (void)
+{
+  SCHEDULE_FUNCTION (test_simd_search);
+}
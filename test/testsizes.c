@@ -9,7 +9,9 @@ test_sizes (void)
   assert (MAX_ARENA < INVALID_REF);
   printf ("sizeof (clause) = %zu\n", sizeof (clause));
   printf ("SIZE_OF_CLAUSE_HEADER = %zu\n", SIZE_OF_CLAUSE_HEADER);
-  assert (SIZE_OF_CLAUSE_HEADER == sizeof (unsigned));
+  assert (SIZE_OF_CLAUSE_HEADER == 2 * sizeof (unsigned));
+  printf ("sizeof (cold) = %zu\n", sizeof (cold));
+  assert (sizeof (cold) == sizeof (unsigned));
   printf ("sizeof (flags) = %zu\n", sizeof (flags));
   assert (sizeof (flags) == 1);
   printf ("sizeof (value) = %zu\n", sizeof (value));
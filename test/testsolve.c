@@ -25,10 +25,14 @@ schedule_solve_job_with_option (int expected,
 static const char *simps[] = {
   "",
 #ifndef NOPTIONS
+  "--compactorder=1 ",
   "--eliminateinit=0 ",
   "--probeinit=0 ",
   "--reduceinit=10 " "--rephaseinit=10 --rephaseint=10 ",
-  "--incremental ",
+  "--incremental=1 ",
+  "--parsethreads=4 ",
+  "--simd=0 ",
+  "--ternary=1 ",
   "--walkinitially ",
 #endif
 };
@@ -93,6 +93,9 @@ tissat_schedule_usage (void)
       APP (0, "--decisions=8e3 ../test/cnf/hard.cnf" LIMITED_OPTIONS);
       APP (0, "--conflicts=7e3 --decisions=7e3 ../test/cnf/hard.cnf"
 	   LIMITED_OPTIONS);
+      APP (0, "--memlimit=0 ../test/cnf/hard.cnf");
+      APP (0, "--threads=2 --conflicts=1e3 ../test/cnf/hard.cnf");
+      APP (20, "--threads=3 ../test/cnf/ph5.cnf");
     }
 
   APP (1, "--help -n");
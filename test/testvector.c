@@ -2,6 +2,7 @@
 
 #include "../src/allocate.h"
 #include "../src/error.h"
+#include "../src/random.h"
 
 #include <inttypes.h>
 
@@ -99,7 +100,94 @@ test_vector_basics (void)
 #ifndef QUIET
   RELEASE_STACK (solver->profiles.stack);
 #endif
-  RELEASE_STACK (*stack);
+  ACCOUNT (vectors, RELEASE_STACK (*stack));
+#ifdef METRICS
+  assert (!solver->statistics.allocated_current);
+#endif
+}
+
+static void
+check_incremental_vectors (kissat * solver, unsigned n, vector * vectors,
+			   const unsigned *count)
+{
+  size_t free = 0;
+  for (all_stack (unsigned, e, solver->vectors.stack))
+    if (e == INVALID_VECTOR_ELEMENT)
+      free++;
+  if (free != solver->vectors.usable)
+    FATAL ("found %zu free entries but %zu usable", free,
+	   solver->vectors.usable);
+  for (unsigned k = 0; k < n; k++)
+    {
+      unsigned c = 0;
+      for (all_vector (u, vectors[k]))
+	{
+	  if (u != k)
+	    FATAL ("unexpected element %u in vector %u", u, k);
+	  c++;
+	}
+      if (c != count[k])
+	FATAL ("vector %u has %u elements but expected %u", k, c, count[k]);
+    }
+}
+
+static void
+test_vector_incremental (void)
+{
+  DECLARE_AND_INIT_SOLVER (solver);
+#ifndef NOPTIONS
+  solver->options.defraglim = 75;
+  solver->options.defragslice = 3;
+#endif
+#define N 16
+  unsigned count[N];
+  vector vector[N];
+  solver->size = solver->vars = N / 2;
+  solver->watches = vector;
+  memset (count, 0, sizeof count);
+  memset (vector, 0, sizeof vector);
+  generator random = 42;
+  unsigned starts = 0, steps = 0, finished = 0;
+  for (unsigned i = 0; i < 4000; i++)
+    {
+      const unsigned j = kissat_pick_random (&random, 0, N);
+      if (!(i % 200))
+	{
+	  kissat_start_defrag_vectors (solver, N, vector);
+	  starts++;
+	}
+      else if (!(i % 3) && !EMPTY_STACK (solver->vectors.defrag.sorted))
+	{
+	  if (kissat_defrag_vectors_step (solver, N, vector))
+	    finished++;
+	  steps++;
+	}
+      else if (kissat_pick_random (&random, 0, 3))
+	{
+	  kissat_push_vectors (solver, &vector[j], j);
+	  count[j]++;
+	}
+      else if (!kissat_pick_random (&random, 0, 8))
+	{
+	  kissat_release_vector (solver, &vector[j]);
+	  count[j] = 0;
+	}
+      else if (!kissat_empty_vector (vector + j))
+	{
+	  kissat_pop_vector (solver, &vector[j]);
+	  count[j]--;
+	}
+      check_incremental_vectors (solver, N, vector, count);
+    }
+#undef N
+  tissat_verbose ("started %u incremental defragmentations "
+		  "with %u steps of which %u finished", starts, steps,
+		  finished);
+  kissat_release_defrag_vectors (solver);
+#ifndef QUIET
+  RELEASE_STACK (solver->profiles.stack);
+#endif
+  ACCOUNT (vectors, RELEASE_STACK (solver->vectors.stack));
 #ifdef METRICS
   assert (!solver->statistics.allocated_current);
 #endif
@@ -148,5 +236,6 @@ void
 tissat_schedule_vector (void)
 {
   SCHEDULE_FUNCTION (test_vector_basics);
+  SCHEDULE_FUNCTION (test_vector_incremental);
   SCHEDULE_FUNCTION (test_vector_fatal);
 }